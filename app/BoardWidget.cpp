@@ -0,0 +1,211 @@
+#include "BoardWidget.h"
+#include "LatencyProbe.h"
+
+#include <QCoreApplication>
+#include <QMouseEvent>
+#include <QPainter>
+
+namespace {
+
+// Medidas da imagem da grade (500x500): as casas ficam numa malha 5x5
+// com passo de 100 a partir de (50, 50); cada peca tem 50 de lado e a
+// area de clique e o quadrado de 100 em volta do centro.
+const int GridSize = 500;
+const int GridMargin = 50;
+const int GridStep = 100;
+const int PieceSize = 50;
+
+const int s_columns[BoardWidget::HoleCount] = { 0, 2, 4, 1, 3, 0, 2, 4, 1, 3, 0, 2, 4 };
+const int s_rows[BoardWidget::HoleCount]    = { 0, 0, 0, 1, 1, 2, 2, 2, 3, 3, 4, 4, 4 };
+
+const char* const s_resources[] = { ":empty", ":red", ":blue", ":selectable", ":grid" };
+const int s_resourceCount = sizeof(s_resources) / sizeof(s_resources[0]);
+
+// As imagens originais sao decodificadas uma unica vez por processo e
+// liberadas junto com a aplicacao, enquanto a plataforma grafica existe.
+QPixmap* s_sources = nullptr;
+int s_pixmapDecodes = 0;
+
+void releaseSources() {
+    delete[] s_sources;
+    s_sources = nullptr;
+}
+
+const QPixmap& source(int image) {
+    if (s_sources == nullptr) {
+        s_sources = new QPixmap[s_resourceCount];
+        qAddPostRoutine(releaseSources);
+    }
+
+    if (s_sources[image].isNull()) {
+        s_sources[image] = QPixmap(s_resources[image]);
+        ++s_pixmapDecodes;
+    }
+    return s_sources[image];
+}
+
+}
+
+BoardWidget::BoardWidget(QWidget *parent)
+        : QWidget(parent),
+          m_holes(0),
+          m_red(0),
+          m_blue(0),
+          m_selectable(0),
+          m_pressed(-1),
+          m_paintCount(0),
+          m_clickTime(0),
+          m_cachedSide(0),
+          m_cachedDpr(0) {
+    this->setSizePolicy(QSizePolicy::Expanding, QSizePolicy::Expanding);
+    this->setAttribute(Qt::WA_OpaquePaintEvent);
+}
+
+BoardWidget::~BoardWidget() {
+}
+
+int BoardWidget::pixmapDecodes() {
+    return s_pixmapDecodes;
+}
+
+QSize BoardWidget::sizeHint() const {
+    return QSize(GridSize, GridSize);
+}
+
+QSize BoardWidget::minimumSizeHint() const {
+    return QSize(GridSize / 4, GridSize / 4);
+}
+
+bool BoardWidget::setBoard(Mask holes, Mask red, Mask blue, Mask selectable) {
+    if (holes != m_holes) {
+        m_holes = holes;
+        m_red = red;
+        m_blue = blue;
+        m_selectable = selectable;
+        this->update();
+        return true;
+    }
+
+    const Mask changed = static_cast<Mask>((m_red ^ red) | (m_blue ^ blue) | (m_selectable ^ selectable));
+    m_red = red;
+    m_blue = blue;
+    m_selectable = selectable;
+
+    Mask pending = changed;
+    while (pending)
+        this->update(this->holeRect(popLowestBit(pending)));
+
+    return changed != 0;
+}
+
+void BoardWidget::setLabels(const QVector<QString>& labels) {
+    Q_ASSERT(labels.size() == HoleCount);
+    for (int id = 0; id < HoleCount; ++id) {
+        if (labels[id] != m_labels[id]) {
+            m_labels[id] = labels[id];
+            this->update(this->holeRect(id));
+        }
+    }
+}
+
+// Maior quadrado centralizado no widget.
+QRect BoardWidget::boardRect() const {
+    const int side = qMin(this->width(), this->height());
+    return QRect((this->width() - side) / 2, (this->height() - side) / 2, side, side);
+}
+
+QRect BoardWidget::holeRect(int id) const {
+    const QRect board = this->boardRect();
+    const qreal scale = board.width() / qreal(GridSize);
+    const qreal x = board.x() + (GridMargin + s_columns[id] * GridStep - GridStep / 2) * scale;
+    const qreal y = board.y() + (GridMargin + s_rows[id] * GridStep - GridStep / 2) * scale;
+    return QRectF(x, y, GridStep * scale, GridStep * scale).toAlignedRect();
+}
+
+int BoardWidget::holeAt(const QPoint& pos) const {
+    for (int id = 0; id < HoleCount; ++id) {
+        if ((m_holes & holeBit(id)) && this->holeRect(id).contains(pos))
+            return id;
+    }
+    return -1;
+}
+
+BoardWidget::Image BoardWidget::imageAt(int id) const {
+    const Mask bit = holeBit(id);
+    if (m_red & bit)
+        return RedImage;
+    if (m_blue & bit)
+        return BlueImage;
+    if (m_selectable & bit)
+        return SelectableImage;
+    return EmptyImage;
+}
+
+void BoardWidget::updateCache() {
+    const int side = this->boardRect().width();
+    const qreal dpr = this->devicePixelRatioF();
+    if (side == m_cachedSide && dpr == m_cachedDpr)
+        return;
+
+    m_cachedSide = side;
+    m_cachedDpr = dpr;
+
+    const qreal scale = side / qreal(GridSize);
+    for (int image = 0; image < ImageCount; ++image) {
+        const int size = qMax(1, qRound((image == GridImage ? GridSize : PieceSize) * scale * dpr));
+        m_scaled[image] = source(image).scaled(size, size, Qt::KeepAspectRatio, Qt::SmoothTransformation);
+        m_scaled[image].setDevicePixelRatio(dpr);
+    }
+}
+
+void BoardWidget::paintEvent(QPaintEvent* event) {
+    ++m_paintCount;
+    this->updateCache();
+
+    QPainter painter(this);
+    painter.fillRect(this->rect(), Qt::white);
+
+    const QRect board = this->boardRect();
+    painter.drawPixmap(board.topLeft(), m_scaled[GridImage]);
+
+    const QSizeF pieceSize = QSizeF(m_scaled[EmptyImage].size()) / m_cachedDpr;
+
+    // Os textos ocupam a faixa entre a peca e a borda da area da casa.
+    QFont font = painter.font();
+    font.setPixelSize(qMax(8, board.width() / 32));
+    font.setBold(true);
+    painter.setFont(font);
+    for (int id = 0; id < HoleCount; ++id) {
+        if (!(m_holes & holeBit(id)))
+            continue;
+
+        const QRect rect = this->holeRect(id);
+        if (!event->region().intersects(rect))
+            continue;
+
+        const QPointF center = QRectF(rect).center();
+        painter.drawPixmap(center - QPointF(pieceSize.width() / 2, pieceSize.height() / 2),
+                           m_scaled[this->imageAt(id)]);
+        if (!m_labels[id].isEmpty())
+            painter.drawText(rect, Qt::AlignHCenter | Qt::AlignBottom, m_labels[id]);
+    }
+
+    painter.end();
+    emit painted();
+}
+
+void BoardWidget::mousePressEvent(QMouseEvent* event) {
+    m_pressed = event->button() == Qt::LeftButton ? this->holeAt(event->pos()) : -1;
+}
+
+void BoardWidget::mouseReleaseEvent(QMouseEvent* event) {
+    if (event->button() != Qt::LeftButton)
+        return;
+
+    m_clickTime = LatencyProbe::now();
+    const int id = this->holeAt(event->pos());
+    const bool clicked = id != -1 && id == m_pressed;
+    m_pressed = -1;
+    if (clicked)
+        emit holeClicked(id);
+}
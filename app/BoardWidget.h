@@ -0,0 +1,83 @@
+#ifndef BOARDWIDGET_H
+#define BOARDWIDGET_H
+
+#include <QWidget>
+#include <QPixmap>
+#include <QVector>
+
+#include "Bits.h"
+
+// Tabuleiro inteiro num unico widget: grade, pecas e casas selecionaveis
+// sao desenhadas num so paintEvent a partir das mascaras do modelo, e o
+// clique e convertido em casa pela geometria.
+class BoardWidget : public QWidget {
+    Q_OBJECT
+
+public:
+    static const int HoleCount = 13;
+
+    explicit BoardWidget(QWidget *parent = nullptr);
+    virtual ~BoardWidget();
+
+    // Novo retrato do tabuleiro; so as casas que mudaram sao repintadas.
+    // Retorna falso quando nada mudou e nenhuma pintura foi agendada.
+    bool setBoard(Mask holes, Mask red, Mask blue, Mask selectable);
+
+    // Textos curtos sob as pecas, um por casa (vazio = nenhum); so as
+    // casas cujo texto mudou sao repintadas.
+    void setLabels(const QVector<QString>& labels);
+
+    int holeAt(const QPoint& pos) const;
+    QRect holeRect(int id) const;
+
+    // Pinturas feitas desde a criacao do widget.
+    int paintCount() const { return m_paintCount; }
+
+    // Instante (LatencyProbe::now) em que chegou o ultimo clique numa casa.
+    qint64 clickTime() const { return m_clickTime; }
+
+    // Quantas imagens ja foram decodificadas dos recursos no processo.
+    static int pixmapDecodes();
+
+    QSize sizeHint() const override;
+    QSize minimumSizeHint() const override;
+
+signals:
+    void holeClicked(int id);
+    void painted();
+
+protected:
+    void paintEvent(QPaintEvent* event) override;
+    void mousePressEvent(QMouseEvent* event) override;
+    void mouseReleaseEvent(QMouseEvent* event) override;
+
+private:
+    enum Image {
+        EmptyImage,
+        RedImage,
+        BlueImage,
+        SelectableImage,
+        GridImage,
+        ImageCount
+    };
+
+    Mask m_holes;
+    Mask m_red;
+    Mask m_blue;
+    Mask m_selectable;
+    QString m_labels[HoleCount];
+    int m_pressed;
+    int m_paintCount;
+    qint64 m_clickTime;
+
+    // Imagens ja redimensionadas para o tamanho e o device pixel ratio atuais.
+    int m_cachedSide;
+    qreal m_cachedDpr;
+    QPixmap m_scaled[ImageCount];
+
+    QRect boardRect() const;
+    Image imageAt(int id) const;
+    void updateCache();
+};
+
+#endif // BOARDWIDGET_H
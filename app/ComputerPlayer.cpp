@@ -0,0 +1,48 @@
+#include "ComputerPlayer.h"
+#include "Trace.h"
+
+#include <QThread>
+
+ComputerPlayer::ComputerPlayer(QObject *parent)
+        : QObject(parent),
+          m_request(NoRequest),
+          m_engine(ComputerPlayer::AlphaBetaEngine),
+          m_books{ nullptr, nullptr } {
+    this->setTimeLimit(500);
+    m_search.setThreadCount(QThread::idealThreadCount());
+    m_mcts.setThreadCount(QThread::idealThreadCount());
+    m_limits.ticket = &m_request;
+    m_mctsLimits.ticket = &m_request;
+}
+
+ComputerPlayer::~ComputerPlayer() {
+}
+
+void ComputerPlayer::setEngine(int engine) {
+    m_engine = static_cast<Engine>(engine);
+}
+
+void ComputerPlayer::think(const Board& board, int request) {
+    PICARIA_TRACE_THREAD("computer");
+    PICARIA_TRACE_SCOPE1("think", "request", request);
+    // Abandonado enquanto esperava na fila.
+    if (m_request.load() != static_cast<uint64_t>(request))
+        return;
+
+    m_limits.ticketValue = static_cast<uint64_t>(request);
+    m_mctsLimits.ticketValue = static_cast<uint64_t>(request);
+
+    const OpeningBook* book = m_books[board.mode()];
+    Move move = book ? book->probe(board) : Move();
+    if (move.isNull()) {
+        if (m_engine == ComputerPlayer::MonteCarloEngine)
+            move = m_mcts.run(board, m_mctsLimits).move;
+        else
+            move = m_search.run(board, m_limits).move;
+    }
+
+    if (!move.isNull() && m_request.load() == static_cast<uint64_t>(request)) {
+        int from = move.isDrop() ? -1 : move.from();
+        emit moveChosen(request, from, move.to());
+    }
+}
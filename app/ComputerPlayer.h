@@ -0,0 +1,70 @@
+#ifndef COMPUTERPLAYER_H
+#define COMPUTERPLAYER_H
+
+#include <QObject>
+#include <QMetaType>
+
+#include "Board.h"
+#include "Mcts.h"
+#include "OpeningBook.h"
+#include "Search.h"
+
+#include <atomic>
+#include <cstdint>
+
+Q_DECLARE_METATYPE(Board)
+
+// Adversario controlado pelo computador. Vive numa thread propria: recebe
+// a posicao por sinal enfileirado e devolve a jogada escolhida da mesma forma.
+class ComputerPlayer : public QObject {
+    Q_OBJECT
+
+public:
+    enum Engine {
+        AlphaBetaEngine,
+        MonteCarloEngine
+    };
+    Q_ENUM(Engine)
+
+    explicit ComputerPlayer(QObject *parent = nullptr);
+    virtual ~ComputerPlayer();
+
+    // Limites da busca; 0 desliga o limite correspondente.
+    void setTimeLimit(int ms) { m_limits.maxTimeMs = ms; m_mctsLimits.maxTimeMs = ms; }
+    void setNodeLimit(quint64 nodes) { m_limits.maxNodes = nodes; m_mctsLimits.maxPlayouts = nodes; }
+
+    // Livro consultado na fase de colocar; deve ser definido antes da
+    // primeira jogada e viver mais que o ComputerPlayer.
+    void setOpeningBook(Board::Mode mode, const OpeningBook* book) { m_books[mode] = book; }
+
+    // Unico pedido que ainda vale: os outros sao abandonados, mesmo os que
+    // ainda esperam na fila da thread. Pode ser chamado de qualquer thread,
+    // antes de emitir o pedido.
+    void setRequest(int request) { m_request.store(static_cast<uint64_t>(request)); }
+
+    // Abandona todos os pedidos feitos ate aqui; pode ser chamado de
+    // qualquer thread.
+    void stop() { m_request.store(NoRequest); }
+
+public slots:
+    void think(const Board& board, int request);
+    void setEngine(int engine);
+
+signals:
+    void moveChosen(int request, int from, int to);
+
+private:
+    static const uint64_t NoRequest = ~uint64_t(0);
+
+    // Bilhete das buscas (Search::Limits::ticket).
+    std::atomic<uint64_t> m_request;
+    Engine m_engine;
+    const OpeningBook* m_books[2];
+    Search m_search;
+    Search::Limits m_limits;
+    Mcts m_mcts;
+    Mcts::Limits m_mctsLimits;
+
+};
+
+#endif // COMPUTERPLAYER_H
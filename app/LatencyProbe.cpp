@@ -0,0 +1,199 @@
+#include "LatencyProbe.h"
+
+#include <QFile>
+#include <QTextStream>
+
+#include <algorithm>
+#include <chrono>
+
+LatencyProbe::LatencyProbe()
+    : m_state(Idle),
+      m_written(0) {
+    std::fill(m_marks, m_marks + StageCount + 1, 0);
+}
+
+int64_t LatencyProbe::now() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+const char* LatencyProbe::stageName(Stage stage) {
+    static const char* const names[StageCount] = {
+        "dispatch", "rules", "state", "paint", "total"
+    };
+    return names[stage];
+}
+
+// Limite superior da faixa em nanossegundos; a ultima nao tem limite.
+int64_t LatencyProbe::bucketLimit(int bucket) {
+    return bucket < BucketCount - 1 ? int64_t(1000) << bucket : -1;
+}
+
+void LatencyProbe::clickReceived(int64_t time) {
+    m_marks[0] = time;
+    m_state = Dispatched;
+}
+
+void LatencyProbe::actionStarted() {
+    const int64_t time = LatencyProbe::now();
+    if (m_state != Dispatched)
+        m_marks[0] = time;
+    m_marks[1] = time;
+    m_state = Started;
+}
+
+void LatencyProbe::renderStarted() {
+    if (m_state != Started)
+        return;
+
+    m_marks[2] = LatencyProbe::now();
+    m_state = Rendering;
+}
+
+void LatencyProbe::renderFinished(bool changed) {
+    if (m_state != Rendering)
+        return;
+
+    m_marks[3] = LatencyProbe::now();
+    if (changed) {
+        m_state = WaitingPaint;
+    } else {
+        // Nada a pintar: o clique termina aqui.
+        m_marks[4] = m_marks[3];
+        this->commit();
+    }
+}
+
+void LatencyProbe::painted() {
+    if (m_state != WaitingPaint)
+        return;
+
+    m_marks[4] = LatencyProbe::now();
+    this->commit();
+}
+
+void LatencyProbe::cancel() {
+    m_state = Idle;
+}
+
+// So a thread da interface escreve; a publicacao e o store com release.
+void LatencyProbe::commit() {
+    const int64_t index = m_written.load(std::memory_order_relaxed);
+    Sample& sample = m_samples[index & (Capacity - 1)];
+    for (int stage = 0; stage < TotalStage; ++stage)
+        sample.stages[stage] = m_marks[stage + 1] - m_marks[stage];
+    sample.stages[TotalStage] = m_marks[TotalStage] - m_marks[0];
+
+    m_written.store(index + 1, std::memory_order_release);
+    m_state = Idle;
+}
+
+// Copia as amostras publicadas e descarta as que o escritor possa ter
+// sobrescrito durante a copia.
+QVector<LatencyProbe::Sample> LatencyProbe::snapshot() const {
+    const int64_t end = m_written.load(std::memory_order_acquire);
+    const int64_t begin = std::max<int64_t>(0, end - Capacity);
+
+    QVector<Sample> samples;
+    samples.reserve(int(end - begin));
+    for (int64_t index = begin; index < end; ++index)
+        samples.append(m_samples[index & (Capacity - 1)]);
+
+    const int64_t after = m_written.load(std::memory_order_acquire);
+    const int64_t overwritten = std::max<int64_t>(0, after - Capacity - begin);
+    if (overwritten > 0)
+        samples.remove(0, int(std::min<int64_t>(overwritten, samples.size())));
+
+    return samples;
+}
+
+LatencyProbe::Histogram LatencyProbe::histogram() const {
+    const QVector<Sample> samples = this->snapshot();
+
+    Histogram result;
+    result.samples = samples.size();
+    std::fill(&result.buckets[0][0], &result.buckets[0][0] + StageCount * BucketCount, 0);
+    std::fill(&result.percentiles[0][0], &result.percentiles[0][0] + StageCount * 3, 0);
+    std::fill(result.maximum, result.maximum + StageCount, 0);
+
+    QVector<int64_t> values(samples.size());
+    for (int stage = 0; stage < StageCount; ++stage) {
+        for (int i = 0; i < samples.size(); ++i) {
+            const int64_t value = samples[i].stages[stage];
+            values[i] = value;
+
+            int bucket = 0;
+            while (bucket < BucketCount - 1 && value >= bucketLimit(bucket))
+                ++bucket;
+            ++result.buckets[stage][bucket];
+        }
+
+        if (values.isEmpty())
+            continue;
+
+        std::sort(values.begin(), values.end());
+        static const int ranks[3] = { 50, 90, 99 };
+        for (int p = 0; p < 3; ++p)
+            result.percentiles[stage][p] = values[(values.size() - 1) * ranks[p] / 100];
+        result.maximum[stage] = values.last();
+    }
+
+    return result;
+}
+
+QString LatencyProbe::toJson() const {
+    const Histogram histogram = this->histogram();
+
+    QString json;
+    QTextStream out(&json);
+    out << "{\n  \"unit\": \"ns\",\n  \"samples\": " << histogram.samples << ",\n  \"stages\": {\n";
+    for (int stage = 0; stage < StageCount; ++stage) {
+        out << "    \"" << stageName(Stage(stage)) << "\": {"
+            << " \"p50\": " << histogram.percentiles[stage][0]
+            << ", \"p90\": " << histogram.percentiles[stage][1]
+            << ", \"p99\": " << histogram.percentiles[stage][2]
+            << ", \"max\": " << histogram.maximum[stage]
+            << ", \"buckets\": [";
+        for (int bucket = 0; bucket < BucketCount; ++bucket) {
+            out << (bucket ? ", " : "") << "{ \"below\": ";
+            if (bucketLimit(bucket) < 0)
+                out << "null";
+            else
+                out << bucketLimit(bucket);
+            out << ", \"count\": " << histogram.buckets[stage][bucket] << " }";
+        }
+        out << "] }" << (stage + 1 < StageCount ? "," : "") << "\n";
+    }
+    out << "  }\n}\n";
+    out.flush();
+
+    return json;
+}
+
+QString LatencyProbe::toCsv() const {
+    const Histogram histogram = this->histogram();
+
+    QString csv;
+    QTextStream out(&csv);
+    out << "stage,below_ns,count\n";
+    for (int stage = 0; stage < StageCount; ++stage) {
+        for (int bucket = 0; bucket < BucketCount; ++bucket) {
+            out << stageName(Stage(stage)) << ',';
+            if (bucketLimit(bucket) >= 0)
+                out << bucketLimit(bucket);
+            out << ',' << histogram.buckets[stage][bucket] << '\n';
+        }
+    }
+    out.flush();
+
+    return csv;
+}
+
+bool LatencyProbe::save(const QString& fileName) const {
+    QFile file(fileName);
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Text | QIODevice::Truncate))
+        return false;
+
+    const QString text = fileName.endsWith(".csv", Qt::CaseInsensitive) ? this->toCsv() : this->toJson();
+    return file.write(text.toUtf8()) != -1;
+}
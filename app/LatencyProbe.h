@@ -0,0 +1,88 @@
+#ifndef LATENCYPROBE_H
+#define LATENCYPROBE_H
+
+#include <QString>
+#include <QVector>
+
+#include <atomic>
+#include <cstdint>
+
+// Mede quanto tempo cada clique leva do evento do mouse ate a tela:
+//   despacho  - do mouseReleaseEvent do tabuleiro ate a entrada em play()
+//   regras    - de play() ate o primeiro render()
+//   estado    - o proprio render(), que repassa as mascaras ao tabuleiro
+//   pintura   - do fim do render() ate o fim do paintEvent seguinte
+// As amostras ficam num anel de tamanho fixo escrito sem travas pela
+// thread da interface; qualquer thread pode tirar um retrato dele.
+class LatencyProbe {
+public:
+    enum Stage {
+        DispatchStage,
+        RulesStage,
+        StateStage,
+        PaintStage,
+        TotalStage,
+        StageCount
+    };
+
+    // Potencia de dois: o indice do anel e so uma mascara.
+    static const int Capacity = 4096;
+
+    // Faixas do histograma: [0, 1us), [1, 2us), [2, 4us), ... e o resto.
+    static const int BucketCount = 24;
+
+    struct Sample {
+        int64_t stages[StageCount];
+    };
+
+    struct Histogram {
+        int samples;
+        int64_t buckets[StageCount][BucketCount];
+        int64_t percentiles[StageCount][3];  // p50, p90, p99
+        int64_t maximum[StageCount];
+    };
+
+    LatencyProbe();
+
+    // Relogio monotono em nanossegundos usado por todas as marcacoes.
+    static int64_t now();
+
+    static const char* stageName(Stage stage);
+    static int64_t bucketLimit(int bucket);
+
+    void clickReceived(int64_t time);
+    void actionStarted();
+    void renderStarted();
+    void renderFinished(bool changed);
+    void painted();
+    void cancel();
+
+    int64_t recorded() const { return m_written.load(std::memory_order_acquire); }
+    QVector<Sample> snapshot() const;
+    Histogram histogram() const;
+
+    QString toJson() const;
+    QString toCsv() const;
+
+    // Formato escolhido pela extensao (.csv ou, por padrao, JSON).
+    bool save(const QString& fileName) const;
+
+private:
+    enum State {
+        Idle,
+        Dispatched,
+        Started,
+        Rendering,
+        WaitingPaint
+    };
+
+    State m_state;
+    int64_t m_marks[StageCount + 1];
+
+    Sample m_samples[Capacity];
+    std::atomic<int64_t> m_written;
+
+    void commit();
+};
+
+#endif // LATENCYPROBE_H
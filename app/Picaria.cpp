@@ -0,0 +1,570 @@
+#include "Picaria.h"
+#include "ui_Picaria.h"
+#include "ComputerPlayer.h"
+#include "Trace.h"
+
+#include <QDebug>
+#include <QDir>
+#include <QFileDialog>
+#include <QGuiApplication>
+#include <QMessageBox>
+#include <QActionGroup>
+#include <QScreen>
+
+
+// Empate quando a mesma posicao aparece tres vezes ou depois de 200 lances
+// na fase de mover.
+static const int s_repetitions = 3;
+static const int s_moveLimit = 200;
+
+static_assert(int(Picaria::RedPlayer) == int(Board::RedPlayer) &&
+              int(Picaria::BluePlayer) == int(Board::BluePlayer),
+              "Picaria::Player must mirror Board::Player");
+static_assert(int(Picaria::NineHoles) == int(Board::NineHoles) &&
+              int(Picaria::ThirteenHoles) == int(Board::ThirteenHoles),
+              "Picaria::Mode must mirror Board::Mode");
+
+Picaria::Picaria(QWidget *parent)
+    : QMainWindow(parent),
+      ui(new Ui::Picaria),
+      m_mode(Picaria::NineHoles),
+      m_board(Board::NineHoles),
+      m_draws(s_repetitions, s_moveLimit),
+      m_drawVerdict(DrawRules::NoDraw),
+      m_selected(-1),
+      m_selectable(0),
+      m_actionPaintCount(0),
+      m_lastActionRepaints(0),
+      m_computer(nullptr),
+      m_request(0),
+      m_thinking(false),
+      m_analysisPosition(0),
+      m_hasAnalysis(false) {
+
+    PICARIA_TRACE_THREAD("ui");
+    ui->setupUi(this);
+
+    QActionGroup* modeGroup = new QActionGroup(this);
+    modeGroup->setExclusive(true);
+    modeGroup->addAction(ui->action9holes);
+    modeGroup->addAction(ui->action13holes);
+
+    QObject::connect(ui->actionNew, SIGNAL(triggered(bool)), this, SLOT(reset()));
+    QObject::connect(ui->actionUndo, SIGNAL(triggered(bool)), this, SLOT(undo()));
+    QObject::connect(ui->actionRedo, SIGNAL(triggered(bool)), this, SLOT(redo()));
+    QObject::connect(ui->actionHint, SIGNAL(triggered(bool)), this, SLOT(showHint()));
+    QObject::connect(ui->actionQuit, SIGNAL(triggered(bool)), qApp, SLOT(quit()));
+    QObject::connect(modeGroup, SIGNAL(triggered(QAction*)), this, SLOT(updateMode(QAction*)));
+    QObject::connect(this, SIGNAL(modeChanged(Picaria::Mode)), this, SLOT(reset()));
+    QObject::connect(ui->actionAbout, SIGNAL(triggered(bool)), this, SLOT(showAbout()));
+    QObject::connect(this, SIGNAL(gameOver(Player)), this, SLOT(showGameOver(Player)));
+    QObject::connect(this, SIGNAL(gameOver(Player)), this, SLOT(reset()));
+    QObject::connect(this, SIGNAL(gameDrawn()), this, SLOT(showGameDrawn()));
+    QObject::connect(this, SIGNAL(gameDrawn()), this, SLOT(reset()));
+
+    QObject::connect(ui->board, SIGNAL(holeClicked(int)), this, SLOT(play(int)));
+    QObject::connect(ui->board, SIGNAL(painted()), this, SLOT(updateLatency()));
+    QObject::connect(ui->actionLatency, SIGNAL(triggered(bool)), this, SLOT(exportLatency()));
+
+    qRegisterMetaType<Board>("Board");
+
+    this->loadOpeningBook(Board::NineHoles);
+    this->loadOpeningBook(Board::ThirteenHoles);
+
+    m_computer = new ComputerPlayer;
+    m_computer->setOpeningBook(Board::NineHoles, &m_books[Board::NineHoles]);
+    m_computer->setOpeningBook(Board::ThirteenHoles, &m_books[Board::ThirteenHoles]);
+    m_computer->moveToThread(&m_computerThread);
+    QObject::connect(&m_computerThread, SIGNAL(finished()), m_computer, SLOT(deleteLater()));
+    QObject::connect(this, SIGNAL(computerTurn(Board,int)), m_computer, SLOT(think(Board,int)));
+    QObject::connect(m_computer, SIGNAL(moveChosen(int,int,int)), this, SLOT(playComputerMove(int,int,int)));
+    QObject::connect(ui->actionComputer, SIGNAL(toggled(bool)), this, SLOT(updateComputer()));
+
+    QActionGroup* engineGroup = new QActionGroup(this);
+    engineGroup->setExclusive(true);
+    engineGroup->addAction(ui->actionAlphaBeta);
+    engineGroup->addAction(ui->actionMonteCarlo);
+    QObject::connect(engineGroup, SIGNAL(triggered(QAction*)), this, SLOT(updateEngine(QAction*)));
+    m_computerThread.start();
+
+    // A fila da analise e esvaziada no maximo uma vez por quadro da tela.
+    const QScreen* screen = QGuiApplication::primaryScreen();
+    const qreal refreshRate = screen && screen->refreshRate() > 0 ? screen->refreshRate() : 60;
+    m_analysisTimer.setInterval(qMax(1, qRound(1000 / refreshRate)));
+    QObject::connect(&m_analysisTimer, SIGNAL(timeout()), this, SLOT(drainAnalysis()));
+    QObject::connect(ui->actionAnalyse, SIGNAL(toggled(bool)), this, SLOT(updateAnalysis()));
+    QObject::connect(ui->actionAnalyse, SIGNAL(toggled(bool)), this, SLOT(updateStatusBar()));
+
+    this->loadTablebase(Board::NineHoles);
+    this->loadTablebase(Board::ThirteenHoles);
+
+    this->reset();
+    this->adjustSize();
+}
+
+Picaria::~Picaria() {
+    // PICARIA_LATENCY=arquivo.json (ou .csv) grava o histograma ao sair.
+    const QString latencyFile = qEnvironmentVariable("PICARIA_LATENCY");
+    if (!latencyFile.isEmpty() && !m_latency.save(latencyFile))
+        qWarning() << "could not write latency histogram to" << latencyFile;
+
+#ifdef PICARIA_TRACING
+    // PICARIA_TRACE=arquivo.json grava a linha do tempo ao sair.
+    const QString traceFile = qEnvironmentVariable("PICARIA_TRACE");
+    if (!traceFile.isEmpty() && !Trace::save(traceFile.toStdString()))
+        qWarning() << "could not write trace to" << traceFile;
+#endif
+
+    m_computer->stop();
+    m_computerThread.quit();
+    m_computerThread.wait();
+
+    delete ui;
+}
+
+void Picaria::setMode(Picaria::Mode mode) {
+    if (m_mode != mode) {
+        m_mode = mode;
+        emit modeChanged(mode);
+    }
+}
+
+// Clique do jogador no tabuleiro: so ele entra nas medidas de latencia.
+void Picaria::play(int id) {
+    if (m_thinking || !m_board.isHole(id))
+        return;
+
+    m_latency.clickReceived(ui->board->clickTime());
+    m_latency.actionStarted();
+
+    m_lastActionRepaints = ui->board->paintCount() - m_actionPaintCount;
+    m_actionPaintCount = ui->board->paintCount();
+
+    this->press(id);
+}
+
+// Regras de um clique numa casa, do jogador ou do computador.
+void Picaria::press(int id) {
+    PICARIA_TRACE_SCOPE1("play", "hole", id);
+    switch (m_board.phase()) {
+        case Board::DropPhase:
+            drop(id);
+            break;
+        case Board::MovePhase:
+            move(id);
+            break;
+        default:
+            Q_UNREACHABLE();
+    }
+
+    this->render();
+}
+
+void Picaria::drop(int id) {
+    PICARIA_TRACE_SCOPE1("drop", "hole", id);
+    Move movement = Move::drop(id);
+    if (!m_board.isLegal(movement))
+        return;
+
+    this->apply(movement);
+}
+
+void Picaria::move(int id) {
+    PICARIA_TRACE_SCOPE1("move", "hole", id);
+    Move movement;
+    if (m_selectable & holeBit(id)) {
+        Q_ASSERT(m_selected != -1);
+        movement = Move::step(m_selected, id);
+    } else if (m_board.hasPiece(m_board.player(), id)) {
+        Mask targets = this->findSelectables(id);
+        if (bitCount(targets) == 1) {
+            movement = Move::step(id, lowestBit(targets));
+        } else if (targets != 0) {
+            m_selectable = targets;
+            m_selected = id;
+        }
+    }
+
+    if (!movement.isNull()) {
+        m_selectable = 0;
+        m_selected = -1;
+
+        this->apply(movement);
+    }
+}
+
+void Picaria::apply(Move movement) {
+    Q_ASSERT(m_board.isLegal(movement));
+
+    Picaria::Player player = this->player();
+    m_board.play(movement);
+    m_history.push(movement);
+    this->updateHistory();
+
+    if (isGameOver(player, movement.to())) {
+        this->pauseAnalysis();
+        this->render();
+        emit gameOver(player);
+        return;
+    }
+
+    m_drawVerdict = m_draws.push(m_board);
+    if (m_drawVerdict != DrawRules::NoDraw) {
+        this->pauseAnalysis();
+        this->render();
+        emit gameDrawn();
+        return;
+    }
+
+    this->nextTurn();
+}
+
+// Contra o computador, desfazer e refazer andam de vez em vez do jogador:
+// a resposta do computador vai junto com a jogada que a provocou.
+void Picaria::undo() {
+    if (m_thinking) {
+        m_computer->stop();
+        m_thinking = false;
+    }
+    ++m_request;
+
+    for (int i = 0; i < 2 && m_history.canUndo(); ++i) {
+        if (i == 1 && !this->isComputerTurn())
+            break;
+        m_board.unplay(m_history.undo());
+        m_draws.pop();
+    }
+
+    m_selected = -1;
+    m_selectable = 0;
+    this->render();
+    this->updateHistory();
+    this->nextTurn();
+}
+
+void Picaria::redo() {
+    if (m_thinking || !m_history.canRedo())
+        return;
+
+    for (int i = 0; i < 2 && m_history.canRedo(); ++i) {
+        if (i == 1 && !this->isComputerTurn())
+            break;
+        m_board.play(m_history.redo());
+        m_draws.push(m_board);
+    }
+
+    m_selected = -1;
+    m_selectable = 0;
+    this->render();
+    this->updateHistory();
+    this->nextTurn();
+}
+
+void Picaria::updateHistory() {
+    ui->actionUndo->setEnabled(m_history.canUndo());
+    ui->actionRedo->setEnabled(m_history.canRedo());
+}
+
+// Resposta do computador: reproduz os cliques que um jogador faria, mas
+// sem passar pela LatencyProbe, que mede so os cliques do mouse.
+void Picaria::playComputerMove(int request, int from, int to) {
+    if (request != m_request || !m_thinking)
+        return;
+
+    m_thinking = false;
+    if (from == -1) {
+        this->press(to);
+    } else {
+        this->press(from);
+        if (m_selected == from)
+            this->press(to);
+    }
+}
+
+bool Picaria::isComputerTurn() const {
+    return ui->actionComputer->isChecked() && m_board.player() == Board::BluePlayer;
+}
+
+void Picaria::nextTurn() {
+    if (this->isComputerTurn() && !m_thinking) {
+        m_thinking = true;
+        m_computer->setRequest(++m_request);
+        emit computerTurn(m_board, m_request);
+    }
+
+    this->updateAnalysis();
+    this->updateStatusBar();
+}
+
+void Picaria::updateComputer() {
+    if (!ui->actionComputer->isChecked() && m_thinking) {
+        m_computer->stop();
+        m_thinking = false;
+        ++m_request;
+    }
+
+    this->nextTurn();
+}
+
+// A analise so roda na vez de um jogador humano; cada posicao nova
+// abandona a anterior sem esperar por ela.
+void Picaria::updateAnalysis() {
+    if (!ui->actionAnalyse->isChecked() || m_thinking || this->isComputerTurn()) {
+        this->pauseAnalysis();
+        return;
+    }
+
+    m_analysisPosition = m_analyser.analyse(m_board);
+    m_hasAnalysis = false;
+    m_analysisTimer.start();
+    this->updateAnnotations();
+}
+
+void Picaria::pauseAnalysis() {
+    m_analyser.pause();
+    m_analysisTimer.stop();
+    m_hasAnalysis = false;
+    this->updateAnnotations();
+}
+
+// Fica com a atualizacao mais recente da posicao atual; as de posicoes
+// anteriores que ainda estavam na fila sao descartadas.
+void Picaria::drainAnalysis() {
+    Analyser::Update update;
+    bool fresh = false;
+    while (m_analyser.poll(update)) {
+        if (update.position == m_analysisPosition) {
+            m_analysis = update;
+            fresh = true;
+        }
+    }
+    if (!fresh)
+        return;
+
+    m_hasAnalysis = true;
+    if (m_analysis.finished)
+        m_analysisTimer.stop();
+
+    this->updateAnnotations();
+    this->updateStatusBar();
+}
+
+// Pontuacao curta: V e D com os lances ate a vitoria ou a derrota.
+static QString scoreText(int score) {
+    if (score >= Search::WinThreshold)
+        return QString("V%1").arg(Search::WinScore - score);
+    if (score <= -Search::WinThreshold)
+        return QString("D%1").arg(Search::WinScore + score);
+    return (score > 0 ? QString("+") : QString()) + QString::number(score);
+}
+
+static QString moveText(Move movement) {
+    if (movement.isDrop())
+        return QString::number(movement.to() + 1);
+    return QString("%1-%2").arg(movement.from() + 1).arg(movement.to() + 1);
+}
+
+// Cada pontuacao fica na casa que o jogador clicaria: o destino ao colocar
+// ou com uma peca selecionada; antes de selecionar, a propria peca, com a
+// melhor das suas jogadas (as jogadas chegam da melhor para a pior).
+void Picaria::updateAnnotations() {
+    QVector<QString> labels(BoardWidget::HoleCount);
+    if (m_hasAnalysis) {
+        for (int i = 0; i < m_analysis.moveCount; ++i) {
+            const Move movement = m_analysis.moves[i];
+            int id = movement.to();
+            if (!movement.isDrop()) {
+                if (m_selected == -1)
+                    id = movement.from();
+                else if (movement.from() != m_selected)
+                    continue;
+            }
+            if (labels[id].isEmpty())
+                labels[id] = scoreText(m_analysis.scores[i]);
+        }
+    }
+    ui->board->setLabels(labels);
+}
+
+void Picaria::updateEngine(QAction* action) {
+    int engine = action == ui->actionMonteCarlo ?
+                ComputerPlayer::MonteCarloEngine : ComputerPlayer::AlphaBetaEngine;
+
+    // Enfileirado: so muda entre uma jogada e outra do computador.
+    QMetaObject::invokeMethod(m_computer, "setEngine", Qt::QueuedConnection, Q_ARG(int, engine));
+}
+
+Mask Picaria::findSelectables(int id) const {
+    PICARIA_TRACE_SCOPE1("findSelectables", "hole", id);
+    return m_board.moveTargets(id);
+}
+
+void Picaria::render() {
+    PICARIA_TRACE_SCOPE("render");
+    m_latency.renderStarted();
+    const bool changed = ui->board->setBoard(m_board.holes(), m_board.pieces(Board::RedPlayer),
+                                             m_board.pieces(Board::BluePlayer), m_selectable);
+    m_latency.renderFinished(changed);
+
+    this->updateAnnotations();
+}
+
+int Picaria::repaintsSinceLastAction() const {
+    return ui->board->paintCount() - m_actionPaintCount;
+}
+
+void Picaria::reset() {
+    PICARIA_TRACE_SCOPE1("reset", "mode", m_mode);
+    if (m_thinking) {
+        m_computer->stop();
+        m_thinking = false;
+    }
+    ++m_request;
+
+    m_board.reset(static_cast<Board::Mode>(m_mode));
+    m_history.clear();
+    m_draws.reset(m_board);
+    m_selected = -1;
+    m_selectable = 0;
+    this->render();
+    this->updateHistory();
+
+    ui->actionHint->setEnabled(m_tablebases[m_board.mode()].isValid());
+
+    this->updateAnalysis();
+    this->updateStatusBar();
+}
+
+// Arquivos gerados pelas ferramentas ficam ao lado do executavel e sao
+// mapeados em memoria; sem eles o jogo funciona, apenas sem dicas e sem
+// livro de aberturas.
+static const uchar* mapFile(QFile& file, const char* name) {
+    file.setFileName(QDir(QCoreApplication::applicationDirPath()).filePath(name));
+    if (!file.open(QIODevice::ReadOnly))
+        return nullptr;
+
+    return file.map(0, file.size());
+}
+
+void Picaria::loadTablebase(Board::Mode mode) {
+    QFile& file = m_tablebaseFiles[mode];
+    const uchar* data = mapFile(file, Tablebase::fileName(mode));
+    if (file.isOpen() && !m_tablebases[mode].attach(data, static_cast<size_t>(file.size()), mode)) {
+        qWarning() << "invalid tablebase: " << file.fileName();
+        file.close();
+    }
+}
+
+void Picaria::loadOpeningBook(Board::Mode mode) {
+    QFile& file = m_bookFiles[mode];
+    const uchar* data = mapFile(file, OpeningBook::fileName(mode));
+    if (file.isOpen() && !m_books[mode].attach(data, static_cast<size_t>(file.size()), mode)) {
+        qWarning() << "invalid opening book: " << file.fileName();
+        file.close();
+    }
+}
+
+void Picaria::showHint() {
+    const Tablebase& tablebase = m_tablebases[m_board.mode()];
+    Move best = tablebase.isValid() ? tablebase.bestMove(m_board) : Move();
+    if (best.isNull())
+        return;
+
+    QString hint = best.isDrop() ?
+                tr("colocar na casa %1").arg(best.to() + 1) :
+                tr("mover da casa %1 para a casa %2").arg(best.from() + 1).arg(best.to() + 1);
+
+    uint16_t entry = tablebase.entry(m_board);
+    switch (Tablebase::result(entry)) {
+        case Tablebase::Win:
+            hint += tr(" (vitoria em %1 lances)").arg(Tablebase::distance(entry));
+            break;
+        case Tablebase::Loss:
+            hint += tr(" (derrota em %1 lances)").arg(Tablebase::distance(entry));
+            break;
+        case Tablebase::Draw:
+            hint += tr(" (empate)");
+            break;
+        default:
+            break;
+    }
+
+    ui->statusbar->showMessage(tr("Dica: %1").arg(hint));
+}
+
+void Picaria::showAbout() {
+    QMessageBox::information(this, tr("About"), tr("Picaria\n\nAlex Meireles Santos Almeida - alexmeirelesalmeida@hotmail.com\n\nVitor Theodoro Rocha Domingues - vitor-theodoro@hotmail.com\n"));
+}
+
+void Picaria::updateMode(QAction* action) {
+    if (action == ui->action9holes)
+        this->setMode(Picaria::NineHoles);
+    else if (action == ui->action13holes)
+        this->setMode(Picaria::ThirteenHoles);
+    else
+        Q_UNREACHABLE();
+}
+
+void Picaria::updateStatusBar() {
+    QString player(this->player() == Picaria::RedPlayer ? "vermelho" : "azul");
+    QString phase(this->phase() == Picaria::DropPhase ? "colocar" : "mover");
+
+    QString message = m_thinking ?
+                tr("Fase de %1: o computador (%2) esta pensando").arg(phase).arg(player) :
+                tr("Fase de %1: vez do jogador %2").arg(phase).arg(player);
+
+    if (m_hasAnalysis && m_analysis.moveCount > 0) {
+        QStringList line;
+        for (int i = 0; i < m_analysis.pvLength; ++i)
+            line << moveText(m_analysis.pv[i]);
+        message += tr(" | analise em %1 lances: %2 (%3), linha %4").arg(m_analysis.depth)
+                .arg(moveText(m_analysis.best())).arg(scoreText(m_analysis.bestScore())).arg(line.join(' '));
+    }
+
+    ui->statusbar->showMessage(message);
+}
+void Picaria::showGameOver(Player player) {
+
+    switch (player) {
+        case Picaria::RedPlayer:
+            QMessageBox::information(this, tr("Vencedor"), tr("Parabéns, o jogador vermelho venceu."));
+            break;
+        case Picaria::BluePlayer:
+            QMessageBox::information(this, tr("Vencedor"), tr("Parabéns, o jogador azul venceu."));
+            break;
+        default:
+            Q_UNREACHABLE();
+    }
+}
+
+void Picaria::showGameDrawn() {
+    if (m_drawVerdict == DrawRules::Repetition)
+        QMessageBox::information(this, tr("Empate"), tr("A mesma posição se repetiu %1 vezes; a partida terminou empatada.").arg(s_repetitions));
+    else
+        QMessageBox::information(this, tr("Empate"), tr("Foram %1 lances sem vencedor; a partida terminou empatada.").arg(s_moveLimit));
+}
+
+bool Picaria::isGameOver(Picaria::Player player, int id) {
+    PICARIA_TRACE_SCOPE2("isGameOver", "player", player, "hole", id);
+    return m_board.isWinningHole(static_cast<Board::Player>(player), id);
+}
+
+void Picaria::updateLatency() {
+    m_latency.painted();
+}
+
+void Picaria::exportLatency() {
+    QString fileName = QFileDialog::getSaveFileName(this, tr("Exportar latencias"),
+        QDir::home().filePath("picaria-latencia.json"), tr("JSON (*.json);;CSV (*.csv)"));
+    if (fileName.isEmpty())
+        return;
+
+    if (!m_latency.save(fileName)) {
+        QMessageBox::warning(this, tr("Exportar latencias"),
+            tr("Nao foi possivel gravar %1.").arg(QDir::toNativeSeparators(fileName)));
+        return;
+    }
+
+    this->statusBar()->showMessage(tr("%1 cliques medidos gravados em %2")
+        .arg(m_latency.recorded()).arg(QDir::toNativeSeparators(fileName)), 5000);
+}
@@ -0,0 +1,149 @@
+#ifndef PICARIA_H
+#define PICARIA_H
+
+#include <QMainWindow>
+#include <QList>
+#include <QFile>
+#include <QThread>
+#include <QTimer>
+
+#include "Analyser.h"
+#include "Board.h"
+#include "DrawRules.h"
+#include "MoveHistory.h"
+#include "OpeningBook.h"
+#include "Tablebase.h"
+#include "LatencyProbe.h"
+
+QT_BEGIN_NAMESPACE
+namespace Ui {
+    class Picaria;
+}
+QT_END_NAMESPACE
+
+class ComputerPlayer;
+
+class Picaria : public QMainWindow {
+    Q_OBJECT
+    Q_PROPERTY(Picaria::Mode mode READ mode WRITE setMode NOTIFY modeChanged)
+
+public:
+    enum Mode {
+        NineHoles,
+        ThirteenHoles
+    };
+    Q_ENUM(Mode)
+
+    enum Player {
+        RedPlayer,
+        BluePlayer
+    };
+    Q_ENUM(Player)
+
+    enum Phase {
+        DropPhase,
+        MovePhase
+    };
+    Q_ENUM(Phase)
+
+    Picaria(QWidget *parent = nullptr);
+    virtual ~Picaria();
+
+    Picaria::Mode mode() const { return m_mode; }
+    void setMode(Picaria::Mode mode);
+
+    Picaria::Player player() const { return static_cast<Picaria::Player>(m_board.player()); }
+    Picaria::Phase phase() const { return static_cast<Picaria::Phase>(m_board.phase()); }
+
+    // Pinturas do tabuleiro desde o ultimo clique e no clique anterior.
+    int repaintsSinceLastAction() const;
+    int lastActionRepaints() const { return m_lastActionRepaints; }
+
+    // Tempos de cada etapa dos cliques do jogador.
+    const LatencyProbe& latency() const { return m_latency; }
+
+signals:
+    void modeChanged(Picaria::Mode mode);
+    void gameOver(Player player);
+    void gameDrawn();
+    void computerTurn(const Board& board, int request);
+
+private:
+    Ui::Picaria *ui;
+    Mode m_mode;
+    Board m_board;
+    MoveHistory m_history;
+    DrawRules m_draws;
+    DrawRules::Verdict m_drawVerdict;
+    int m_selected;
+    Mask m_selectable;
+
+    int m_actionPaintCount;
+    int m_lastActionRepaints;
+    LatencyProbe m_latency;
+
+    QFile m_tablebaseFiles[2];
+    Tablebase m_tablebases[2];
+
+    void loadTablebase(Board::Mode mode);
+
+    // Os livros precisam viver mais que a thread do computador, que os consulta.
+    QFile m_bookFiles[2];
+    OpeningBook m_books[2];
+
+    void loadOpeningBook(Board::Mode mode);
+
+    // O computador joga com as pecas azuis.
+    QThread m_computerThread;
+    ComputerPlayer* m_computer;
+    int m_request;
+    bool m_thinking;
+
+    bool isComputerTurn() const;
+    void nextTurn();
+
+    // Analise na vez do jogador: o timer esvazia a fila do Analyser no
+    // ritmo da tela e so as atualizacoes da posicao atual sao mostradas.
+    Analyser m_analyser;
+    Analyser::Update m_analysis;
+    uint32_t m_analysisPosition;
+    bool m_hasAnalysis;
+    QTimer m_analysisTimer;
+
+    void pauseAnalysis();
+    void updateAnnotations();
+
+    bool isGameOver(Picaria::Player player, int id);
+
+    void press(int id);
+    void drop(int id);
+    void move(int id);
+    void apply(Move movement);
+    void updateHistory();
+
+    Mask findSelectables(int id) const;
+    void render();
+
+private slots:
+    void play(int id);
+    void playComputerMove(int request, int from, int to);
+    void reset();
+    void undo();
+    void redo();
+
+    void showAbout();
+    void showHint();
+    void showGameOver(Player player);
+    void showGameDrawn();
+    void updateMode(QAction* action);
+    void updateStatusBar();
+    void updateComputer();
+    void updateAnalysis();
+    void drainAnalysis();
+    void updateEngine(QAction* action);
+    void updateLatency();
+    void exportLatency();
+
+};
+
+#endif // PICARIA_H
@@ -0,0 +1,36 @@
+QT       += core gui widgets testlib
+
+TARGET = tst_clickreplay
+
+# make check roda o teste.
+CONFIG += console c++11 testcase
+CONFIG -= app_bundle
+
+include(../../engine/engine.pri)
+
+# A janela inteira vem de app/, sem o main.cpp.
+APP_DIR = ../../app
+INCLUDEPATH += $$APP_DIR
+DEPENDPATH += $$APP_DIR
+
+# sequences.txt e baseline.txt ficam ao lado do codigo.
+DEFINES += CLICKREPLAY_SOURCE_DIR=\\\"$$PWD\\\"
+
+SOURCES += \
+    tst_clickreplay.cpp \
+    $$APP_DIR/BoardWidget.cpp \
+    $$APP_DIR/ComputerPlayer.cpp \
+    $$APP_DIR/LatencyProbe.cpp \
+    $$APP_DIR/Picaria.cpp
+
+HEADERS += \
+    $$APP_DIR/BoardWidget.h \
+    $$APP_DIR/ComputerPlayer.h \
+    $$APP_DIR/LatencyProbe.h \
+    $$APP_DIR/Picaria.h
+
+FORMS += \
+    $$APP_DIR/Picaria.ui
+
+RESOURCES += \
+    $$APP_DIR/Picaria.qrc
@@ -0,0 +1,383 @@
+// Repete os cliques gravados em sequences.txt numa janela Picaria de
+// verdade, sem tela (plataforma offscreen), e mede o caminho inteiro de cada
+// clique: evento do mouse no tabuleiro, sinal holeClicked, play(), render(),
+// a atualizacao das casas e a pintura. Falha se as alocacoes por clique
+// passarem das de baseline.txt ou se o tempo por clique piorar.
+//
+// As alocacoes nao dependem da maquina: baseline.txt fica no repositorio e
+// sem ela o teste falha. O tempo depende: a referencia vai para
+// clickreplay-timing.txt, ao lado do executavel, e e gravada na primeira
+// execucao em cada diretorio de build.
+//
+// Uso: tst_clickreplay (ou make check). Variaveis de ambiente:
+//   PICARIA_BASELINE=arquivo       outra baseline de alocacoes
+//   PICARIA_UPDATE_BASELINE=1      regrava as duas com os valores medidos
+//   PICARIA_BASELINE_TOLERANCE=N   folga do tempo, em porcentagem (25)
+
+#include "BoardWidget.h"
+#include "Picaria.h"
+
+#include <QAction>
+#include <QApplication>
+#include <QElapsedTimer>
+#include <QFile>
+#include <QSysInfo>
+#include <QTextStream>
+#include <QTimer>
+#include <QtTest>
+
+#include <cstdlib>
+#include <new>
+
+namespace {
+
+// Alocacoes feitas pela thread da interface enquanto um clique e medido.
+// Na glibc o malloc e substituido, o que pega tambem os buffers do Qt (que
+// nao passam pelo operator new); nos outros sistemas conta so o new.
+thread_local bool t_counting = false;
+quint64 s_allocations = 0;
+
+inline void countAllocation() {
+    if (t_counting)
+        ++s_allocations;
+}
+
+}
+
+#if defined(__GLIBC__)
+extern "C" {
+
+void* __libc_malloc(size_t size);
+void* __libc_calloc(size_t count, size_t size);
+void* __libc_realloc(void* pointer, size_t size);
+
+void* malloc(size_t size) noexcept {
+    countAllocation();
+    return __libc_malloc(size);
+}
+
+void* calloc(size_t count, size_t size) noexcept {
+    countAllocation();
+    return __libc_calloc(count, size);
+}
+
+void* realloc(void* pointer, size_t size) noexcept {
+    countAllocation();
+    return __libc_realloc(pointer, size);
+}
+
+}
+#else
+void* operator new(size_t size) {
+    countAllocation();
+    void* pointer = std::malloc(size ? size : 1);
+    if (pointer == nullptr)
+        throw std::bad_alloc();
+    return pointer;
+}
+
+void* operator new[](size_t size) {
+    return ::operator new(size);
+}
+
+void operator delete(void* pointer) noexcept {
+    std::free(pointer);
+}
+
+void operator delete[](void* pointer) noexcept {
+    std::free(pointer);
+}
+#endif
+
+class ClickReplay : public QObject {
+    Q_OBJECT
+
+private slots:
+    void initTestCase();
+    void cleanupTestCase();
+    void clickTime();
+    void clickAllocations();
+
+private:
+    static const int TimedPasses = 5;
+
+    struct Command {
+        enum Kind {
+            Mode,
+            Reset,
+            Play
+        };
+
+        Kind kind;
+        int mode;
+        QVector<int> holes;
+    };
+
+    QVector<Command> m_commands;
+    int m_clicks;
+
+    Picaria* m_window;
+    BoardWidget* m_board;
+    QAction* m_modeActions[2];
+    QTimer m_dialogGuard;
+    bool m_dialogShown;
+
+    enum Metric {
+        Nanoseconds,
+        Allocations
+    };
+
+    QString m_baselineFile[2];
+    double m_baseline[2];       // por clique; 0 = sem baseline
+    double m_measured[2];
+
+    bool loadSequences(const QString& fileName);
+    void loadBaseline(int metric);
+    bool saveBaseline(int metric) const;
+
+    void replay(qint64* nanoseconds, quint64* allocations);
+    void click(int id, qint64* nanoseconds, quint64* allocations);
+    void compare(int metric, double tolerance);
+
+    static const char* const Keys[2];
+};
+
+const char* const ClickReplay::Keys[2] = { "nanoseconds-per-click", "allocations-per-click" };
+
+bool ClickReplay::loadSequences(const QString& fileName) {
+    QFile file(fileName);
+    if (!file.open(QIODevice::ReadOnly | QIODevice::Text))
+        return false;
+
+    QTextStream in(&file);
+    while (!in.atEnd()) {
+        const QString line = in.readLine().simplified();
+        if (line.isEmpty() || line.startsWith('#'))
+            continue;
+
+        const QStringList words = line.split(' ');
+
+        Command command;
+        command.mode = 0;
+        if (words[0] == "mode" && words.size() == 2) {
+            command.kind = Command::Mode;
+            command.mode = words[1] == "13" ? Picaria::ThirteenHoles : Picaria::NineHoles;
+        } else if (words[0] == "reset") {
+            command.kind = Command::Reset;
+        } else if (words[0] == "play") {
+            command.kind = Command::Play;
+            for (int i = 1; i < words.size(); ++i)
+                command.holes << words[i].toInt();
+            m_clicks += command.holes.size();
+        } else {
+            qWarning() << "unknown command:" << words.join(' ');
+            return false;
+        }
+        m_commands << command;
+    }
+    return true;
+}
+
+void ClickReplay::loadBaseline(int metric) {
+    m_baseline[metric] = 0;
+
+    QFile file(m_baselineFile[metric]);
+    if (!file.open(QIODevice::ReadOnly | QIODevice::Text))
+        return;
+
+    QTextStream in(&file);
+    while (!in.atEnd()) {
+        const QStringList words = in.readLine().simplified().split(' ');
+        if (words.size() == 2 && words[0] == Keys[metric])
+            m_baseline[metric] = words[1].toDouble();
+    }
+}
+
+bool ClickReplay::saveBaseline(int metric) const {
+    QFile file(m_baselineFile[metric]);
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Text | QIODevice::Truncate))
+        return false;
+
+    QTextStream out(&file);
+    out << "# Gravado por tst_clickreplay (PICARIA_UPDATE_BASELINE=1 regrava).\n"
+        << "# Qt " << qVersion() << ", " << QSysInfo::prettyProductName() << " " << QSysInfo::currentCpuArchitecture() << "\n"
+        << Keys[metric] << " ";
+    if (metric == Nanoseconds)
+        out << qRound64(m_measured[metric]) << "\n";
+    else
+        out << QString::number(m_measured[metric], 'f', 1) << "\n";
+    return true;
+}
+
+void ClickReplay::initTestCase() {
+    m_window = nullptr;
+    m_clicks = 0;
+    m_measured[Nanoseconds] = m_measured[Allocations] = 0;
+    QVERIFY2(this->loadSequences(QString(CLICKREPLAY_SOURCE_DIR) + "/sequences.txt"), "cannot read sequences.txt");
+    QVERIFY(m_clicks > 0);
+
+    m_baselineFile[Nanoseconds] = QCoreApplication::applicationDirPath() + "/clickreplay-timing.txt";
+    m_baselineFile[Allocations] = qEnvironmentVariable("PICARIA_BASELINE", QString(CLICKREPLAY_SOURCE_DIR) + "/baseline.txt");
+    for (int metric = Nanoseconds; metric <= Allocations; ++metric)
+        this->loadBaseline(metric);
+
+    m_window = new Picaria;
+    m_window->show();
+    QVERIFY(QTest::qWaitForWindowExposed(m_window));
+
+    m_board = m_window->findChild<BoardWidget*>("board");
+    m_modeActions[Picaria::NineHoles] = m_window->findChild<QAction*>("action9holes");
+    m_modeActions[Picaria::ThirteenHoles] = m_window->findChild<QAction*>("action13holes");
+    QVERIFY(m_board && m_modeActions[Picaria::NineHoles] && m_modeActions[Picaria::ThirteenHoles]);
+
+    // Uma partida que termina abre uma caixa de mensagem modal e travaria o
+    // teste; o guarda a fecha e o teste falha.
+    m_dialogShown = false;
+    m_dialogGuard.setInterval(100);
+    QObject::connect(&m_dialogGuard, &QTimer::timeout, [this]() {
+        if (QWidget* dialog = QApplication::activeModalWidget()) {
+            m_dialogShown = true;
+            dialog->close();
+        }
+    });
+    m_dialogGuard.start();
+
+    // Primeira passada fora da medida: decodifica as imagens, enche os
+    // caches de fontes e de estilo.
+    this->replay(nullptr, nullptr);
+    if (QTest::currentTestFailed())
+        return;
+    QVERIFY2(!m_dialogShown, "a recorded game ended and opened a message box");
+}
+
+void ClickReplay::cleanupTestCase() {
+    delete m_window;
+    m_window = nullptr;
+
+    // Sem PICARIA_UPDATE_BASELINE so a referencia de tempo, que e local,
+    // e gravada sozinha; a de alocacoes vem do repositorio.
+    const bool update = qEnvironmentVariableIsSet("PICARIA_UPDATE_BASELINE");
+    for (int metric = Nanoseconds; metric <= Allocations; ++metric) {
+        const bool missing = metric == Nanoseconds && m_baseline[metric] == 0;
+        if ((update || missing) && m_measured[metric] > 0) {
+            QVERIFY2(this->saveBaseline(metric), qPrintable("cannot write " + m_baselineFile[metric]));
+            qInfo() << "baseline written to" << m_baselineFile[metric];
+        }
+    }
+}
+
+void ClickReplay::replay(qint64* nanoseconds, quint64* allocations) {
+    for (const Command& command : m_commands) {
+        switch (command.kind) {
+            case Command::Mode:
+                // Como o grupo do menu: marca a acao e chama updateMode().
+                m_modeActions[command.mode]->setChecked(true);
+                QVERIFY(QMetaObject::invokeMethod(m_window, "updateMode", Qt::DirectConnection,
+                                                  Q_ARG(QAction*, m_modeActions[command.mode])));
+                break;
+            case Command::Reset:
+                QVERIFY(QMetaObject::invokeMethod(m_window, "reset", Qt::DirectConnection));
+                break;
+            case Command::Play:
+                for (int id : command.holes)
+                    this->click(id, nanoseconds, allocations);
+                break;
+        }
+        if (QTest::currentTestFailed())
+            return;
+        QCoreApplication::processEvents();
+    }
+}
+
+// Um clique termina quando a LatencyProbe da janela registra a amostra:
+// logo depois do render() se nada mudou, ou depois da pintura seguinte.
+void ClickReplay::click(int id, qint64* nanoseconds, quint64* allocations) {
+    const QPoint position = m_board->holeRect(id).center();
+    const qint64 samples = m_window->latency().recorded();
+
+    QElapsedTimer timer;
+    const quint64 allocated = s_allocations;
+    t_counting = true;
+    timer.start();
+
+    QTest::mouseClick(m_board, Qt::LeftButton, Qt::NoModifier, position);
+    while (m_window->latency().recorded() == samples && timer.elapsed() < 5000)
+        QCoreApplication::processEvents(QEventLoop::WaitForMoreEvents);
+
+    const qint64 elapsed = timer.nsecsElapsed();
+    t_counting = false;
+    QVERIFY2(m_window->latency().recorded() != samples, qPrintable(QString("click on hole %1 never finished").arg(id)));
+
+    if (nanoseconds)
+        *nanoseconds += elapsed;
+    if (allocations)
+        *allocations += s_allocations - allocated;
+}
+
+void ClickReplay::compare(int metric, double tolerance) {
+    const char* name = Keys[metric];
+    if (m_baseline[metric] == 0) {
+        if (metric == Nanoseconds) {
+            qInfo() << "no baseline for" << name << "yet, recording one in" << m_baselineFile[metric];
+            return;
+        }
+        if (qEnvironmentVariableIsSet("PICARIA_UPDATE_BASELINE"))
+            return;
+        QFAIL(qPrintable(QString("no %1 in %2 (PICARIA_UPDATE_BASELINE=1 writes it)").arg(QString(name), m_baselineFile[metric])));
+    }
+
+    const double limit = m_baseline[metric] * (1 + tolerance / 100);
+    qInfo().nospace() << name << ": " << m_measured[metric] << " (baseline " << m_baseline[metric]
+                      << ", limit " << limit << ")";
+    QVERIFY2(m_measured[metric] <= limit,
+             qPrintable(QString("%1 regressed: %2 > %3").arg(name).arg(m_measured[metric]).arg(limit)));
+}
+
+// Melhor media de varias passadas: o ruido da maquina so aumenta o tempo.
+void ClickReplay::clickTime() {
+    double best = 0;
+    for (int pass = 0; pass < TimedPasses; ++pass) {
+        qint64 nanoseconds = 0;
+        this->replay(&nanoseconds, nullptr);
+        if (QTest::currentTestFailed())
+            return;
+
+        const double perClick = double(nanoseconds) / m_clicks;
+        if (pass == 0 || perClick < best)
+            best = perClick;
+    }
+    QVERIFY(!m_dialogShown);
+
+    m_measured[Nanoseconds] = best;
+    QTest::setBenchmarkResult(best, QTest::WalltimeNanoseconds);
+
+    bool ok = false;
+    double tolerance = qEnvironmentVariable("PICARIA_BASELINE_TOLERANCE").toDouble(&ok);
+    this->compare(Nanoseconds, ok ? tolerance : 25);
+}
+
+// As alocacoes quase nao variam entre passadas; a folga de 10% cobre os
+// caches internos do Qt.
+void ClickReplay::clickAllocations() {
+    quint64 allocations = 0;
+    this->replay(nullptr, &allocations);
+    if (QTest::currentTestFailed())
+        return;
+    QVERIFY(!m_dialogShown);
+
+    m_measured[Allocations] = double(allocations) / m_clicks;
+    QTest::setBenchmarkResult(m_measured[Allocations], QTest::Events);
+    this->compare(Allocations, 10);
+}
+
+int main(int argc, char *argv[]) {
+    // Sem tela: a janela e pintada num buffer.
+    if (!qEnvironmentVariableIsSet("QT_QPA_PLATFORM"))
+        qputenv("QT_QPA_PLATFORM", "offscreen");
+
+    QApplication app(argc, argv);
+    ClickReplay test;
+    return QTest::qExec(&test, argc, argv);
+}
+
+#include "tst_clickreplay.moc"
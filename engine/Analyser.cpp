@@ -0,0 +1,175 @@
+#include "Analyser.h"
+#include "Trace.h"
+
+namespace {
+
+// Pedido: bits 0-15 vermelhas, 16-31 azuis, 32 jogador, 33 modo, 34 ativo
+// e, dali para cima, o numero da posicao.
+const int PositionShift = 35;
+const uint32_t PositionMask = (1u << (64 - PositionShift)) - 1;
+const uint64_t ActiveBit = uint64_t(1) << 34;
+
+}
+
+Analyser::Analyser(size_t hashMegabytes)
+    : m_quit(false),
+      m_request(0),
+      m_position(0),
+      m_search(hashMegabytes) {
+    m_thread = std::thread(&Analyser::run, this);
+}
+
+Analyser::~Analyser() {
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_quit = true;
+        // Qualquer valor novo interrompe a busca em andamento.
+        m_request.store(m_request.load() ^ ActiveBit);
+    }
+    m_wake.notify_one();
+    m_thread.join();
+}
+
+uint32_t Analyser::analyse(const Board& board) {
+    m_position = (m_position + 1) & PositionMask;
+    if (m_position == 0)
+        m_position = 1;
+
+    this->post(Analyser::pack(board, m_position) | ActiveBit);
+    return m_position;
+}
+
+void Analyser::pause() {
+    m_position = (m_position + 1) & PositionMask;
+    this->post(uint64_t(m_position) << PositionShift);
+}
+
+// A trava so e disputada com o teste do predicado na thread da analise,
+// que dura alguns acessos a memoria; a busca corre sem ela.
+void Analyser::post(uint64_t request) {
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_request.store(request);
+    }
+    m_wake.notify_one();
+}
+
+uint64_t Analyser::pack(const Board& board, uint32_t position) {
+    return uint64_t(board.pieces(Board::RedPlayer)) |
+           uint64_t(board.pieces(Board::BluePlayer)) << 16 |
+           uint64_t(board.player()) << 32 |
+           uint64_t(board.mode()) << 33 |
+           uint64_t(position) << PositionShift;
+}
+
+uint32_t Analyser::position(uint64_t request) {
+    return static_cast<uint32_t>(request >> PositionShift);
+}
+
+void Analyser::run() {
+    PICARIA_TRACE_THREAD("analyser");
+    uint32_t current = 0;
+    for (;;) {
+        uint64_t request;
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_wake.wait(lock, [this, current]() {
+                return m_quit || Analyser::position(m_request.load()) != current;
+            });
+            if (m_quit)
+                return;
+            request = m_request.load();
+        }
+
+        // Um pedido que chegue durante a busca a interrompe e muda a
+        // posicao, entao a volta seguinte do laco o atende sem dormir.
+        current = Analyser::position(request);
+        if (request & ActiveBit)
+            this->deepen(request);
+    }
+}
+
+// Cada jogada da raiz e buscada com janela cheia para que todas tenham
+// pontuacao exata; a tabela de transposicao, mantida entre profundidades e
+// entre posicoes, paga a repeticao.
+void Analyser::deepen(uint64_t request) {
+    const uint32_t position = Analyser::position(request);
+    PICARIA_TRACE_SCOPE1("analyse", "position", position);
+    Board board(static_cast<Board::Mode>((request >> 33) & 1));
+    board.setPosition(static_cast<Mask>(request), static_cast<Mask>(request >> 16),
+                      static_cast<Board::Player>((request >> 32) & 1));
+
+    Update update;
+    update.position = position;
+    update.moveCount = board.generateMoves(update.moves);
+    if (update.moveCount == 0) {
+        update.finished = true;
+        m_updates.push(update);
+        return;
+    }
+
+    const Board::Player player = board.player();
+    Search::Limits limits;
+    limits.ticket = &m_request;
+    limits.ticketValue = request;
+
+    for (int depth = 1; depth < Search::MaxDepth; ++depth) {
+        bool forced = true;
+        for (int i = 0; i < update.moveCount; ++i) {
+            if (this->aborted(request))
+                return;
+
+            Board child(board);
+            child.play(update.moves[i]);
+
+            int score;
+            if (child.isWinningHole(player, update.moves[i].to())) {
+                score = Search::WinScore - 1;
+            } else {
+                limits.maxDepth = depth;
+                const Search::Result result = m_search.run(child, limits);
+                if (this->aborted(request))
+                    return;
+
+                update.nodes += result.nodes;
+                score = -result.score;
+                if (score >= Search::WinThreshold)
+                    --score;
+                else if (score <= -Search::WinThreshold)
+                    ++score;
+            }
+
+            update.scores[i] = score;
+            forced = forced && (score >= Search::WinThreshold || score <= -Search::WinThreshold);
+
+            // Cede o processador entre as buscas da raiz.
+            std::this_thread::yield();
+        }
+
+        // Melhor primeiro; a ordem tambem serve a proxima profundidade.
+        for (int i = 1; i < update.moveCount; ++i) {
+            const Move move = update.moves[i];
+            const int score = update.scores[i];
+            int j = i - 1;
+            for (; j >= 0 && update.scores[j] < score; --j) {
+                update.moves[j + 1] = update.moves[j];
+                update.scores[j + 1] = update.scores[j];
+            }
+            update.moves[j + 1] = move;
+            update.scores[j + 1] = score;
+        }
+
+        update.depth = depth + 1;
+        update.pv[0] = update.best();
+        update.pvLength = 1;
+        Board child(board);
+        child.play(update.pv[0]);
+        if (!child.isWinningHole(player, update.pv[0].to()))
+            update.pvLength += m_search.principalVariation(child, update.pv + 1, MaxPv - 1);
+
+        update.finished = forced || update.bestScore() >= Search::WinThreshold || depth + 1 == Search::MaxDepth;
+        m_updates.push(update);
+        if (update.finished)
+            return;
+    }
+}
@@ -0,0 +1,77 @@
+#ifndef ANALYSER_H
+#define ANALYSER_H
+
+#include "Board.h"
+#include "Search.h"
+#include "SpscRing.h"
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+
+// Analise continua (ponderacao) numa thread propria: aprofunda a busca em
+// cada jogada da raiz ate a posicao mudar e publica, a cada profundidade
+// completa, a pontuacao de todas as jogadas e a variante principal.
+//
+// A thread dona nunca espera pela busca. A posicao pedida vai num unico
+// atomico de 64 bits (vale a mais recente), que tambem serve de bilhete da
+// busca: qualquer pedido novo a interrompe. As atualizacoes voltam por uma
+// SpscRing; com a fila cheia a atualizacao e descartada.
+class Analyser {
+public:
+    static const int MaxPv = 16;
+    static const int UpdateCapacity = 64;
+
+    struct Update {
+        Update() : position(0), depth(0), moveCount(0), pvLength(0), finished(false), nodes(0) {}
+
+        Move best() const { return moveCount ? moves[0] : Move(); }
+        int bestScore() const { return moveCount ? scores[0] : 0; }
+
+        uint32_t position;                  // numero devolvido por analyse()
+        int depth;                          // em lances, contando a jogada da raiz
+        int moveCount;
+        Move moves[Board::MaxMoves];        // da melhor para a pior
+        int scores[Board::MaxMoves];        // do ponto de vista de quem joga
+        int pvLength;
+        Move pv[MaxPv];
+        bool finished;                      // resultado forcado ou profundidade maxima
+        uint64_t nodes;
+    };
+
+    explicit Analyser(size_t hashMegabytes = 8);
+    ~Analyser();
+
+    // Troca a posicao analisada; a busca em andamento e abandonada.
+    // Retorna o numero que identifica as atualizacoes desta posicao.
+    uint32_t analyse(const Board& board);
+
+    // Para de analisar ate o proximo analyse().
+    void pause();
+
+    // Proxima atualizacao publicada, se houver. So a thread dona chama.
+    bool poll(Update& update) { return m_updates.pop(update); }
+
+private:
+    std::thread m_thread;
+    std::mutex m_mutex;
+    std::condition_variable m_wake;
+    bool m_quit;                        // protegido por m_mutex
+    std::atomic<uint64_t> m_request;    // ver pack()
+    uint32_t m_position;
+
+    Search m_search;
+    SpscRing<Update, UpdateCapacity> m_updates;
+
+    void post(uint64_t request);
+    void run();
+    void deepen(uint64_t request);
+    bool aborted(uint64_t request) const { return m_request.load(std::memory_order_relaxed) != request; }
+
+    static uint64_t pack(const Board& board, uint32_t position);
+    static uint32_t position(uint64_t request);
+};
+
+#endif // ANALYSER_H
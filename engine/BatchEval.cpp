@@ -0,0 +1,352 @@
+#include "BatchEval.h"
+#include "Search.h"
+
+// Os nucleos SIMD sao compilados com atributos de alvo e escolhidos em tempo
+// de execucao, entao o motor continua rodando em processadores sem AVX2.
+// PICARIA_NO_SIMD deixa so o nucleo escalar.
+#if !defined(PICARIA_NO_SIMD) && defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define PICARIA_X86_KERNELS
+#include <immintrin.h>
+#endif
+
+namespace {
+
+struct Outputs {
+    uint8_t* winners;
+    uint8_t* moveCounts;
+    int16_t* scores;
+};
+
+void scalarKernel(const Topology& topology, const Evaluation::Weights& weights, const Mask* red, const Mask* blue,
+                  const uint8_t* players, size_t begin, size_t end, const Outputs& out) {
+    for (size_t i = begin; i < end; ++i) {
+        const Mask r = red[i];
+        const Mask b = blue[i];
+
+        bool redWon = false, blueWon = false;
+        for (int l = 0; l < topology.lineCount; ++l) {
+            const Mask line = topology.lines[l];
+            redWon |= (r & line) == line;
+            blueWon |= (b & line) == line;
+        }
+
+        if (out.winners)
+            out.winners[i] = static_cast<uint8_t>((redWon ? BatchEval::RedWon : 0) | (blueWon ? BatchEval::BlueWon : 0));
+
+        const bool blueToMove = out.moveCounts || out.scores ? players[i] == Board::BluePlayer : false;
+        const Mask own = blueToMove ? b : r;
+        const Mask other = blueToMove ? r : b;
+
+        if (out.moveCounts) {
+            const Mask occupied = static_cast<Mask>(r | b);
+            const Mask empty = static_cast<Mask>(topology.holes & ~occupied);
+            int count = 0;
+            if (bitCount(occupied) < Board::DropCount) {
+                count = bitCount(empty);
+            } else {
+                Mask pieces = own;
+                while (pieces)
+                    count += bitCount(topology.adjacency[popLowestBit(pieces)] & empty);
+            }
+            out.moveCounts[i] = static_cast<uint8_t>(count);
+        }
+
+        if (out.scores) {
+            int score;
+            if (redWon || blueWon) {
+                score = redWon == !blueToMove ? Search::WinScore : -Search::WinScore;
+            } else {
+                int values[Evaluation::FeatureCount];
+                Evaluation::features(topology, own, other, values);
+                score = 0;
+                for (int f = 0; f < Evaluation::FeatureCount; ++f)
+                    score += weights.values[f] * values[f];
+            }
+            out.scores[i] = static_cast<int16_t>(score);
+        }
+    }
+}
+
+#ifdef PICARIA_X86_KERNELS
+
+// Contagem de bits em cada faixa de 16 bits.
+__attribute__((target("sse2")))
+inline __m128i popcount16(__m128i x) {
+    const __m128i m1 = _mm_set1_epi16(0x5555);
+    const __m128i m2 = _mm_set1_epi16(0x3333);
+    const __m128i m4 = _mm_set1_epi16(0x0F0F);
+    x = _mm_sub_epi16(x, _mm_and_si128(_mm_srli_epi16(x, 1), m1));
+    x = _mm_add_epi16(_mm_and_si128(x, m2), _mm_and_si128(_mm_srli_epi16(x, 2), m2));
+    x = _mm_and_si128(_mm_add_epi16(x, _mm_srli_epi16(x, 4)), m4);
+    return _mm_and_si128(_mm_add_epi16(x, _mm_srli_epi16(x, 8)), _mm_set1_epi16(0x1F));
+}
+
+__attribute__((target("sse2")))
+inline __m128i blend16(__m128i mask, __m128i ifSet, __m128i ifClear) {
+    return _mm_or_si128(_mm_and_si128(mask, ifSet), _mm_andnot_si128(mask, ifClear));
+}
+
+__attribute__((target("sse2")))
+size_t sse2Kernel(const Topology& topology, const Evaluation::Weights& weights, const Mask* red, const Mask* blue,
+                  const uint8_t* players, size_t count, const Outputs& out) {
+    const size_t Lanes = 8;
+    const size_t end = count - count % Lanes;
+    const bool needPlayers = out.moveCounts || out.scores;
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i one = _mm_set1_epi16(1);
+    const __m128i two = _mm_set1_epi16(2);
+    const __m128i holes = _mm_set1_epi16(static_cast<short>(topology.holes));
+
+    for (size_t i = 0; i < end; i += Lanes) {
+        const __m128i r = _mm_loadu_si128(reinterpret_cast<const __m128i*>(red + i));
+        const __m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i*>(blue + i));
+        // Faixa toda em 1 quando joga o azul.
+        const __m128i blueToMove = needPlayers
+            ? _mm_cmpeq_epi16(_mm_unpacklo_epi8(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(players + i)), zero),
+                              _mm_set1_epi16(Board::BluePlayer))
+            : zero;
+
+        // Caracteristicas de Evaluation como vermelho menos azul.
+        __m128i redWon = zero, blueWon = zero, threats = zero, openLines = zero;
+        for (int l = 0; l < topology.lineCount; ++l) {
+            const __m128i line = _mm_set1_epi16(static_cast<short>(topology.lines[l]));
+            const __m128i rl = _mm_and_si128(r, line);
+            const __m128i bl = _mm_and_si128(b, line);
+            const __m128i redCount = popcount16(rl);
+            const __m128i blueCount = popcount16(bl);
+            const __m128i redOnly = _mm_cmpeq_epi16(bl, zero);
+            const __m128i blueOnly = _mm_cmpeq_epi16(rl, zero);
+            redWon = _mm_or_si128(redWon, _mm_cmpeq_epi16(rl, line));
+            blueWon = _mm_or_si128(blueWon, _mm_cmpeq_epi16(bl, line));
+            threats = _mm_add_epi16(threats, _mm_and_si128(one, _mm_and_si128(redOnly, _mm_cmpeq_epi16(redCount, two))));
+            threats = _mm_sub_epi16(threats, _mm_and_si128(one, _mm_and_si128(blueOnly, _mm_cmpeq_epi16(blueCount, two))));
+            openLines = _mm_add_epi16(openLines, _mm_andnot_si128(blueOnly, _mm_and_si128(redOnly, one)));
+            openLines = _mm_sub_epi16(openLines, _mm_andnot_si128(redOnly, _mm_and_si128(blueOnly, one)));
+        }
+
+        if (out.winners) {
+            const __m128i winners = _mm_or_si128(_mm_and_si128(redWon, _mm_set1_epi16(BatchEval::RedWon)),
+                                                 _mm_and_si128(blueWon, _mm_set1_epi16(BatchEval::BlueWon)));
+            _mm_storel_epi64(reinterpret_cast<__m128i*>(out.winners + i), _mm_packus_epi16(winners, zero));
+        }
+
+        if (!needPlayers)
+            continue;
+
+        // Passos possiveis de cada cor: a mobilidade da avaliacao e, na
+        // fase de mover, o numero de jogadas de quem joga.
+        const __m128i occupied = _mm_or_si128(r, b);
+        const __m128i empty = _mm_andnot_si128(occupied, holes);
+        __m128i redSteps = zero, blueSteps = zero;
+        for (int hole = 0; hole < Board::HoleCount; ++hole) {
+            if (!(topology.holes & holeBit(hole)))
+                continue;
+            const __m128i bit = _mm_set1_epi16(static_cast<short>(holeBit(hole)));
+            const __m128i steps = popcount16(_mm_and_si128(_mm_set1_epi16(static_cast<short>(topology.adjacency[hole])), empty));
+            redSteps = _mm_add_epi16(redSteps, _mm_and_si128(_mm_cmpeq_epi16(_mm_and_si128(r, bit), bit), steps));
+            blueSteps = _mm_add_epi16(blueSteps, _mm_and_si128(_mm_cmpeq_epi16(_mm_and_si128(b, bit), bit), steps));
+        }
+
+        if (out.moveCounts) {
+            const __m128i movePhase = _mm_cmpgt_epi16(popcount16(occupied), _mm_set1_epi16(Board::DropCount - 1));
+            const __m128i counts = blend16(movePhase, blend16(blueToMove, blueSteps, redSteps), popcount16(empty));
+            _mm_storel_epi64(reinterpret_cast<__m128i*>(out.moveCounts + i), _mm_packus_epi16(counts, zero));
+        }
+
+        if (out.scores) {
+            const __m128i centre = _mm_set1_epi16(static_cast<short>(holeBit(Evaluation::CentreHole)));
+            const __m128i centreDiff = _mm_sub_epi16(_mm_srli_epi16(_mm_and_si128(r, centre), Evaluation::CentreHole),
+                                                     _mm_srli_epi16(_mm_and_si128(b, centre), Evaluation::CentreHole));
+            __m128i score = _mm_mullo_epi16(threats, _mm_set1_epi16(static_cast<short>(weights.values[Evaluation::Threats])));
+            score = _mm_add_epi16(score, _mm_mullo_epi16(openLines, _mm_set1_epi16(static_cast<short>(weights.values[Evaluation::OpenLines]))));
+            score = _mm_add_epi16(score, _mm_mullo_epi16(_mm_sub_epi16(redSteps, blueSteps),
+                                                         _mm_set1_epi16(static_cast<short>(weights.values[Evaluation::Mobility]))));
+            score = _mm_add_epi16(score, _mm_mullo_epi16(centreDiff, _mm_set1_epi16(static_cast<short>(weights.values[Evaluation::Centre]))));
+
+            score = blend16(blueWon, _mm_set1_epi16(-Search::WinScore), score);
+            score = blend16(redWon, _mm_set1_epi16(Search::WinScore), score);
+            // Troca o sinal nas faixas do azul: (x ^ -1) - (-1) = -x.
+            score = _mm_sub_epi16(_mm_xor_si128(score, blueToMove), blueToMove);
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(out.scores + i), score);
+        }
+    }
+
+    return end;
+}
+
+__attribute__((target("avx2")))
+inline __m256i popcount16(__m256i x) {
+    const __m256i m1 = _mm256_set1_epi16(0x5555);
+    const __m256i m2 = _mm256_set1_epi16(0x3333);
+    const __m256i m4 = _mm256_set1_epi16(0x0F0F);
+    x = _mm256_sub_epi16(x, _mm256_and_si256(_mm256_srli_epi16(x, 1), m1));
+    x = _mm256_add_epi16(_mm256_and_si256(x, m2), _mm256_and_si256(_mm256_srli_epi16(x, 2), m2));
+    x = _mm256_and_si256(_mm256_add_epi16(x, _mm256_srli_epi16(x, 4)), m4);
+    return _mm256_and_si256(_mm256_add_epi16(x, _mm256_srli_epi16(x, 8)), _mm256_set1_epi16(0x1F));
+}
+
+// Estreita 16 faixas de 16 bits (todas em 0..255) para 16 bytes em ordem.
+__attribute__((target("avx2")))
+inline void storeBytes(uint8_t* target, __m256i values) {
+    const __m128i packed = _mm_packus_epi16(_mm256_castsi256_si128(values), _mm256_extracti128_si256(values, 1));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(target), packed);
+}
+
+__attribute__((target("avx2")))
+size_t avx2Kernel(const Topology& topology, const Evaluation::Weights& weights, const Mask* red, const Mask* blue,
+                  const uint8_t* players, size_t count, const Outputs& out) {
+    const size_t Lanes = 16;
+    const size_t end = count - count % Lanes;
+    const bool needPlayers = out.moveCounts || out.scores;
+    const __m256i zero = _mm256_setzero_si256();
+    const __m256i one = _mm256_set1_epi16(1);
+    const __m256i two = _mm256_set1_epi16(2);
+    const __m256i holes = _mm256_set1_epi16(static_cast<short>(topology.holes));
+
+    for (size_t i = 0; i < end; i += Lanes) {
+        const __m256i r = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(red + i));
+        const __m256i b = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(blue + i));
+        const __m256i blueToMove = needPlayers
+            ? _mm256_cmpeq_epi16(_mm256_cvtepu8_epi16(_mm_loadu_si128(reinterpret_cast<const __m128i*>(players + i))),
+                                 _mm256_set1_epi16(Board::BluePlayer))
+            : zero;
+
+        __m256i redWon = zero, blueWon = zero, threats = zero, openLines = zero;
+        for (int l = 0; l < topology.lineCount; ++l) {
+            const __m256i line = _mm256_set1_epi16(static_cast<short>(topology.lines[l]));
+            const __m256i rl = _mm256_and_si256(r, line);
+            const __m256i bl = _mm256_and_si256(b, line);
+            const __m256i redCount = popcount16(rl);
+            const __m256i blueCount = popcount16(bl);
+            const __m256i redOnly = _mm256_cmpeq_epi16(bl, zero);
+            const __m256i blueOnly = _mm256_cmpeq_epi16(rl, zero);
+            redWon = _mm256_or_si256(redWon, _mm256_cmpeq_epi16(rl, line));
+            blueWon = _mm256_or_si256(blueWon, _mm256_cmpeq_epi16(bl, line));
+            threats = _mm256_add_epi16(threats, _mm256_and_si256(one, _mm256_and_si256(redOnly, _mm256_cmpeq_epi16(redCount, two))));
+            threats = _mm256_sub_epi16(threats, _mm256_and_si256(one, _mm256_and_si256(blueOnly, _mm256_cmpeq_epi16(blueCount, two))));
+            openLines = _mm256_add_epi16(openLines, _mm256_andnot_si256(blueOnly, _mm256_and_si256(redOnly, one)));
+            openLines = _mm256_sub_epi16(openLines, _mm256_andnot_si256(redOnly, _mm256_and_si256(blueOnly, one)));
+        }
+
+        if (out.winners) {
+            storeBytes(out.winners + i,
+                       _mm256_or_si256(_mm256_and_si256(redWon, _mm256_set1_epi16(BatchEval::RedWon)),
+                                       _mm256_and_si256(blueWon, _mm256_set1_epi16(BatchEval::BlueWon))));
+        }
+
+        if (!needPlayers)
+            continue;
+
+        const __m256i occupied = _mm256_or_si256(r, b);
+        const __m256i empty = _mm256_andnot_si256(occupied, holes);
+        __m256i redSteps = zero, blueSteps = zero;
+        for (int hole = 0; hole < Board::HoleCount; ++hole) {
+            if (!(topology.holes & holeBit(hole)))
+                continue;
+            const __m256i bit = _mm256_set1_epi16(static_cast<short>(holeBit(hole)));
+            const __m256i steps = popcount16(_mm256_and_si256(_mm256_set1_epi16(static_cast<short>(topology.adjacency[hole])), empty));
+            redSteps = _mm256_add_epi16(redSteps, _mm256_and_si256(_mm256_cmpeq_epi16(_mm256_and_si256(r, bit), bit), steps));
+            blueSteps = _mm256_add_epi16(blueSteps, _mm256_and_si256(_mm256_cmpeq_epi16(_mm256_and_si256(b, bit), bit), steps));
+        }
+
+        if (out.moveCounts) {
+            const __m256i movePhase = _mm256_cmpgt_epi16(popcount16(occupied), _mm256_set1_epi16(Board::DropCount - 1));
+            storeBytes(out.moveCounts + i,
+                       _mm256_blendv_epi8(popcount16(empty), _mm256_blendv_epi8(redSteps, blueSteps, blueToMove), movePhase));
+        }
+
+        if (out.scores) {
+            const __m256i centre = _mm256_set1_epi16(static_cast<short>(holeBit(Evaluation::CentreHole)));
+            const __m256i centreDiff = _mm256_sub_epi16(_mm256_srli_epi16(_mm256_and_si256(r, centre), Evaluation::CentreHole),
+                                                        _mm256_srli_epi16(_mm256_and_si256(b, centre), Evaluation::CentreHole));
+            __m256i score = _mm256_mullo_epi16(threats, _mm256_set1_epi16(static_cast<short>(weights.values[Evaluation::Threats])));
+            score = _mm256_add_epi16(score, _mm256_mullo_epi16(openLines, _mm256_set1_epi16(static_cast<short>(weights.values[Evaluation::OpenLines]))));
+            score = _mm256_add_epi16(score, _mm256_mullo_epi16(_mm256_sub_epi16(redSteps, blueSteps),
+                                                               _mm256_set1_epi16(static_cast<short>(weights.values[Evaluation::Mobility]))));
+            score = _mm256_add_epi16(score, _mm256_mullo_epi16(centreDiff, _mm256_set1_epi16(static_cast<short>(weights.values[Evaluation::Centre]))));
+
+            score = _mm256_blendv_epi8(score, _mm256_set1_epi16(-Search::WinScore), blueWon);
+            score = _mm256_blendv_epi8(score, _mm256_set1_epi16(Search::WinScore), redWon);
+            score = _mm256_sub_epi16(_mm256_xor_si256(score, blueToMove), blueToMove);
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(out.scores + i), score);
+        }
+    }
+
+    return end;
+}
+
+#endif
+
+}
+
+BatchEval::BatchEval(Board::Mode mode)
+    : m_mode(mode),
+      m_topology(&Board::topology(mode)),
+      m_weights(Evaluation::weights(mode)),
+      m_kernel(BatchEval::bestKernel()) {
+}
+
+BatchEval::Kernel BatchEval::bestKernel() {
+#ifdef PICARIA_X86_KERNELS
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx2"))
+        return Avx2Kernel;
+    if (__builtin_cpu_supports("sse2"))
+        return Sse2Kernel;
+#endif
+    return ScalarKernel;
+}
+
+const char* BatchEval::kernelName(Kernel kernel) {
+    switch (kernel) {
+    case Avx2Kernel:
+        return "avx2";
+    case Sse2Kernel:
+        return "sse2";
+    default:
+        return "scalar";
+    }
+}
+
+void BatchEval::setKernel(Kernel kernel) {
+    const Kernel best = BatchEval::bestKernel();
+    m_kernel = kernel < best ? kernel : best;
+}
+
+void BatchEval::run(const Mask* red, const Mask* blue, const uint8_t* players, size_t count,
+                    uint8_t* winners, uint8_t* moveCounts, int16_t* scores) const {
+    Outputs out = { winners, moveCounts, scores };
+    size_t done = 0;
+
+#ifdef PICARIA_X86_KERNELS
+    if (m_kernel == Avx2Kernel)
+        done = avx2Kernel(*m_topology, m_weights, red, blue, players, count, out);
+    else if (m_kernel == Sse2Kernel)
+        done = sse2Kernel(*m_topology, m_weights, red, blue, players, count, out);
+#endif
+
+    // O que sobra de um registro incompleto vai pelo nucleo escalar.
+    scalarKernel(*m_topology, m_weights, red, blue, players, done, count, out);
+}
+
+void BatchEval::wins(const Mask* red, const Mask* blue, size_t count, uint8_t* winners) const {
+    this->run(red, blue, nullptr, count, winners, nullptr, nullptr);
+}
+
+void BatchEval::moveCounts(const Mask* red, const Mask* blue, const uint8_t* players, size_t count, uint8_t* counts) const {
+    this->run(red, blue, players, count, nullptr, counts, nullptr);
+}
+
+void BatchEval::evaluate(const Mask* red, const Mask* blue, const uint8_t* players, size_t count, int16_t* scores) const {
+    this->run(red, blue, players, count, nullptr, nullptr, scores);
+}
+
+int BatchEval::evaluate(const Board& board) const {
+    const Mask red = board.pieces(Board::RedPlayer);
+    const Mask blue = board.pieces(Board::BluePlayer);
+    const uint8_t player = static_cast<uint8_t>(board.player());
+    int16_t score;
+    Outputs out = { nullptr, nullptr, &score };
+    scalarKernel(board.topology(), Evaluation::weights(board.mode()), &red, &blue, &player, 0, 1, out);
+    return score;
+}
@@ -0,0 +1,68 @@
+#ifndef BATCHEVAL_H
+#define BATCHEVAL_H
+
+#include "Board.h"
+#include "Evaluation.h"
+
+#include <cstddef>
+#include <cstdint>
+
+// Avalia muitas posicoes de um modo de uma vez. As posicoes chegam como
+// estrutura de arrays (mascaras de vermelho e azul e a vez, um elemento por
+// posicao) e cada mascara de 16 bits ocupa uma faixa de um registro SIMD:
+// 8 posicoes por instrucao com SSE2 e 16 com AVX2. As linhas de vitoria e
+// a vizinhanca do modo sao testadas em todas as faixas sem desvios.
+//
+// Os tres nucleos dao o mesmo resultado; o escalar vale em qualquer
+// plataforma e serve de referencia.
+class BatchEval {
+public:
+    enum Kernel {
+        ScalarKernel,
+        Sse2Kernel,
+        Avx2Kernel
+    };
+
+    // Bits de winners[i].
+    enum Winner {
+        RedWon = 1,
+        BlueWon = 2
+    };
+
+    explicit BatchEval(Board::Mode mode);
+
+    Board::Mode mode() const { return m_mode; }
+
+    // O melhor nucleo que o processador suporta; e o padrao.
+    static Kernel bestKernel();
+    static const char* kernelName(Kernel kernel);
+
+    Kernel kernel() const { return m_kernel; }
+    // Nucleos nao suportados caem para o melhor disponivel abaixo deles.
+    void setKernel(Kernel kernel);
+
+    // players[i] e um Board::Player. Qualquer saida pode ser nula; as
+    // pedidas sao calculadas na mesma passada.
+    //
+    // winners: combinacao de RedWon/BlueWon (linhas completas).
+    // moveCounts: o mesmo que Board::generateMoves.
+    // scores: do ponto de vista de quem joga, +-Search::WinScore se alguem
+    //         ja fechou uma linha; senao o mesmo que Evaluation::evaluate.
+    void run(const Mask* red, const Mask* blue, const uint8_t* players, size_t count,
+             uint8_t* winners, uint8_t* moveCounts, int16_t* scores) const;
+
+    void wins(const Mask* red, const Mask* blue, size_t count, uint8_t* winners) const;
+    void moveCounts(const Mask* red, const Mask* blue, const uint8_t* players, size_t count, uint8_t* counts) const;
+    void evaluate(const Mask* red, const Mask* blue, const uint8_t* players, size_t count, int16_t* scores) const;
+
+    // Uma posicao so, pelo nucleo escalar (usa o modo do proprio board).
+    int evaluate(const Board& board) const;
+
+private:
+    Board::Mode m_mode;
+    const Topology* m_topology;
+    Evaluation::Weights m_weights;
+    Kernel m_kernel;
+};
+
+#endif // BATCHEVAL_H
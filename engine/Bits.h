@@ -0,0 +1,60 @@
+#ifndef BITS_H
+#define BITS_H
+
+#include <cstdint>
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+typedef uint16_t Mask;
+
+inline Mask holeBit(int id) {
+    return static_cast<Mask>(1u << id);
+}
+
+inline int bitCount(uint32_t mask) {
+#if defined(_MSC_VER)
+    return static_cast<int>(__popcnt(mask));
+#else
+    return __builtin_popcount(mask);
+#endif
+}
+
+// Indice do bit menos significativo; mask nao pode ser zero.
+inline int lowestBit(uint32_t mask) {
+#if defined(_MSC_VER)
+    unsigned long index;
+    _BitScanForward(&index, mask);
+    return static_cast<int>(index);
+#else
+    return __builtin_ctz(mask);
+#endif
+}
+
+inline int bitCount64(uint64_t mask) {
+#if defined(_MSC_VER)
+    return static_cast<int>(__popcnt64(mask));
+#else
+    return __builtin_popcountll(mask);
+#endif
+}
+
+inline int lowestBit64(uint64_t mask) {
+#if defined(_MSC_VER)
+    unsigned long index;
+    _BitScanForward64(&index, mask);
+    return static_cast<int>(index);
+#else
+    return __builtin_ctzll(mask);
+#endif
+}
+
+// Remove e devolve o indice do bit menos significativo.
+inline int popLowestBit(Mask& mask) {
+    int id = lowestBit(mask);
+    mask = static_cast<Mask>(mask & (mask - 1));
+    return id;
+}
+
+#endif // BITS_H
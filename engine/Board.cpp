@@ -0,0 +1,194 @@
+#include "Board.h"
+#include "BoardDescription.h"
+#include "Zobrist.h"
+
+#include <algorithm>
+#include <cassert>
+#include <set>
+#include <utility>
+#include <vector>
+
+Board::Board(Mode mode)
+    : m_mode(mode),
+      m_topology(&Board::topology(mode)),
+      m_player(Board::RedPlayer),
+      m_dropCount(0),
+      m_hash(Zobrist::mode(mode)) {
+    m_pieces[RedPlayer] = 0;
+    m_pieces[BluePlayer] = 0;
+}
+
+const Topology& Board::topology(Mode mode) {
+    return mode == Board::NineHoles ? Topology::nineHoles() : Topology::thirteenHoles();
+}
+
+bool Board::matches(Mode mode, const BoardDescription& description, std::string* error) {
+    const Topology& topology = Board::topology(mode);
+    std::vector<int> ids;       // casa da descricao -> casa do modo
+    for (int id = 0; id < HoleCount; ++id) {
+        if (topology.holes & holeBit(id))
+            ids.push_back(id);
+    }
+
+    std::string problem;
+    if (description.holeCount != static_cast<int>(ids.size())) {
+        problem = "has " + std::to_string(description.holeCount) + " holes, expected " + std::to_string(ids.size());
+    } else if (description.piecesPerPlayer != PiecesPerPlayer) {
+        problem = "has " + std::to_string(description.piecesPerPlayer) + " pieces per player, expected " +
+                  std::to_string(PiecesPerPlayer);
+    } else {
+        std::set<std::pair<int, int> > edges;
+        for (const std::pair<int, int>& edge : description.edges) {
+            const int a = ids[edge.first];
+            const int b = ids[edge.second];
+            edges.insert(std::make_pair(std::min(a, b), std::max(a, b)));
+        }
+        for (int a = 0; a < HoleCount && problem.empty(); ++a) {
+            Mask neighbours = topology.adjacency[a];
+            while (neighbours) {
+                const int b = popLowestBit(neighbours);
+                if (a < b && !edges.erase(std::make_pair(a, b))) {
+                    problem = "misses the edge " + std::to_string(a) + "-" + std::to_string(b) + " (board numbering)";
+                    break;
+                }
+            }
+        }
+        if (problem.empty() && !edges.empty())
+            problem = "has edges the mode does not have";
+
+        std::set<Mask> lines(topology.lines, topology.lines + topology.lineCount);
+        for (size_t i = 0; i < description.lines.size() && problem.empty(); ++i) {
+            Mask line = 0;
+            for (int hole : description.lines[i])
+                line |= holeBit(ids[hole]);
+            if (!lines.erase(line))
+                problem = "winning line " + std::to_string(i + 1) + " is not a line of the mode";
+        }
+        if (problem.empty() && !lines.empty())
+            problem = "misses winning lines of the mode";
+    }
+
+    if (problem.empty())
+        return true;
+    if (error)
+        *error = description.name + " " + problem;
+    return false;
+}
+
+void Board::reset() {
+    m_pieces[RedPlayer] = 0;
+    m_pieces[BluePlayer] = 0;
+    m_player = Board::RedPlayer;
+    m_dropCount = 0;
+    m_hash = Zobrist::mode(m_mode);
+}
+
+void Board::reset(Mode mode) {
+    m_mode = mode;
+    m_topology = &Board::topology(mode);
+    this->reset();
+}
+
+void Board::setPosition(Mask red, Mask blue, Player player) {
+    assert((red & blue) == 0);
+    assert(((red | blue) & ~m_topology->holes) == 0);
+
+    m_pieces[RedPlayer] = red;
+    m_pieces[BluePlayer] = blue;
+    m_player = player;
+    m_dropCount = bitCount(red) + bitCount(blue);
+    m_hash = Zobrist::hash(*this);
+}
+
+Mask Board::dropTargets() const {
+    return this->phase() == Board::DropPhase ? this->empty() : 0;
+}
+
+Mask Board::moveTargets(int from) const {
+    if (this->phase() != Board::MovePhase || !this->hasPiece(m_player, from))
+        return 0;
+
+    return static_cast<Mask>(m_topology->adjacency[from] & this->empty());
+}
+
+int Board::generateMoves(Move* moves) const {
+    int count = 0;
+    if (this->phase() == Board::DropPhase) {
+        Mask targets = this->empty();
+        while (targets)
+            moves[count++] = Move::drop(popLowestBit(targets));
+    } else {
+        Mask empty = this->empty();
+        Mask pieces = m_pieces[m_player];
+        while (pieces) {
+            int from = popLowestBit(pieces);
+            Mask targets = static_cast<Mask>(m_topology->adjacency[from] & empty);
+            while (targets)
+                moves[count++] = Move::step(from, popLowestBit(targets));
+        }
+    }
+
+    return count;
+}
+
+bool Board::isLegal(Move move) const {
+    if (move.isNull() || !this->isHole(move.to()))
+        return false;
+
+    if (move.isDrop())
+        return (this->dropTargets() & holeBit(move.to())) != 0;
+
+    return this->isHole(move.from()) && (this->moveTargets(move.from()) & holeBit(move.to())) != 0;
+}
+
+void Board::play(Move move) {
+    assert(this->isLegal(move));
+
+    if (move.isDrop())
+        ++m_dropCount;
+    else
+        m_pieces[m_player] &= static_cast<Mask>(~holeBit(move.from()));
+
+    m_pieces[m_player] |= holeBit(move.to());
+    m_hash ^= Zobrist::move(m_player, move);
+    m_player = Board::opponent(m_player);
+}
+
+void Board::unplay(Move move) {
+    m_player = Board::opponent(m_player);
+    m_hash ^= Zobrist::move(m_player, move);
+    assert(this->hasPiece(m_player, move.to()));
+
+    m_pieces[m_player] &= static_cast<Mask>(~holeBit(move.to()));
+    if (move.isDrop())
+        --m_dropCount;
+    else
+        m_pieces[m_player] |= holeBit(move.from());
+}
+
+bool Board::isWinningHole(Player player, int id, Mask* line) const {
+    const Mask pieces = m_pieces[player];
+    const Mask* lines = m_topology->linesAt[id];
+    for (int i = m_topology->lineCountAt[id] - 1; i >= 0; --i) {
+        if ((pieces & lines[i]) == lines[i]) {
+            if (line)
+                *line = lines[i];
+            return true;
+        }
+    }
+
+    return false;
+}
+
+bool Board::hasWon(Player player, Mask* line) const {
+    const Mask pieces = m_pieces[player];
+    for (int i = 0; i < m_topology->lineCount; ++i) {
+        if ((pieces & m_topology->lines[i]) == m_topology->lines[i]) {
+            if (line)
+                *line = m_topology->lines[i];
+            return true;
+        }
+    }
+
+    return false;
+}
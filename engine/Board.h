@@ -0,0 +1,93 @@
+#ifndef BOARD_H
+#define BOARD_H
+
+#include "Bits.h"
+#include "Move.h"
+#include "Topology.h"
+
+#include <string>
+
+struct BoardDescription;
+
+// Estado do jogo sem nenhum widget: uma mascara de bits por jogador.
+class Board {
+public:
+    enum Mode {
+        NineHoles,
+        ThirteenHoles
+    };
+
+    enum Player {
+        RedPlayer,
+        BluePlayer
+    };
+
+    enum Phase {
+        DropPhase,
+        MovePhase
+    };
+
+    static const int HoleCount = Topology::HoleCount;
+    static const int PiecesPerPlayer = 3;
+    static const int DropCount = 2 * PiecesPerPlayer;
+    static const int MaxMoves = PiecesPerPlayer * 8;
+
+    explicit Board(Mode mode = NineHoles);
+
+    static const Topology& topology(Mode mode);
+
+    // Confere se a descricao em texto e o tabuleiro do modo (casas,
+    // vizinhanca, linhas e pecas), com a numeracao de BoardDescription::mode.
+    static bool matches(Mode mode, const BoardDescription& description, std::string* error = nullptr);
+
+    void reset();
+    void reset(Mode mode);
+
+    // Posicao arbitraria; a fase vem do numero de pecas no tabuleiro.
+    void setPosition(Mask red, Mask blue, Player player);
+
+    Mode mode() const { return m_mode; }
+    Player player() const { return m_player; }
+    Phase phase() const { return m_dropCount < DropCount ? DropPhase : MovePhase; }
+    int dropCount() const { return m_dropCount; }
+
+    // Chave de Zobrist da posicao (igual a Zobrist::hash), mantida por
+    // play() e unplay() sem recalcular.
+    uint64_t hash() const { return m_hash; }
+
+    const Topology& topology() const { return *m_topology; }
+    Mask holes() const { return m_topology->holes; }
+    Mask pieces(Player player) const { return m_pieces[player]; }
+    Mask occupied() const { return static_cast<Mask>(m_pieces[RedPlayer] | m_pieces[BluePlayer]); }
+    Mask empty() const { return static_cast<Mask>(m_topology->holes & ~occupied()); }
+
+    bool isHole(int id) const { return id >= 0 && id < HoleCount && (holes() & holeBit(id)); }
+    bool isEmpty(int id) const { return isHole(id) && (empty() & holeBit(id)); }
+    bool hasPiece(Player player, int id) const { return isHole(id) && (m_pieces[player] & holeBit(id)); }
+
+    Mask dropTargets() const;
+    Mask moveTargets(int from) const;
+
+    int generateMoves(Move* moves) const;
+    bool isLegal(Move move) const;
+
+    void play(Move move);
+    // Desfaz a ultima jogada feita com play(move).
+    void unplay(Move move);
+
+    // Verifica so as linhas que passam pela casa id (a ultima que mudou).
+    bool isWinningHole(Player player, int id, Mask* line = nullptr) const;
+    bool hasWon(Player player, Mask* line = nullptr) const;
+
+    static Player opponent(Player player) { return player == RedPlayer ? BluePlayer : RedPlayer; }
+
+private:
+    Mode m_mode;
+    const Topology* m_topology;
+    Mask m_pieces[2];
+    Player m_player;
+    int m_dropCount;
+    uint64_t m_hash;
+};
+
+#endif // BOARD_H
@@ -0,0 +1,160 @@
+#include "BoardDescription.h"
+
+#include <algorithm>
+#include <fstream>
+#include <set>
+#include <sstream>
+
+namespace {
+
+bool fail(std::string* error, const std::string& message) {
+    if (error)
+        *error = message;
+    return false;
+}
+
+bool readHole(const std::string& token, int& hole) {
+    std::istringstream in(token);
+    return (in >> hole) && in.eof();
+}
+
+}
+
+bool BoardDescription::parse(std::istream& in, BoardDescription& description, std::string* error) {
+    description = BoardDescription();
+
+    std::string text;
+    int number = 0;
+    while (std::getline(in, text)) {
+        ++number;
+        text = text.substr(0, text.find('#'));
+
+        std::istringstream line(text);
+        std::string keyword;
+        if (!(line >> keyword))
+            continue;
+
+        const std::string where = "line " + std::to_string(number) + ": ";
+        if (keyword == "name") {
+            std::getline(line >> std::ws, description.name);
+        } else if (keyword == "holes") {
+            if (!(line >> description.holeCount))
+                return fail(error, where + "expected the number of holes");
+        } else if (keyword == "pieces") {
+            if (!(line >> description.piecesPerPlayer))
+                return fail(error, where + "expected the number of pieces per player");
+        } else if (keyword == "edges") {
+            std::string token;
+            while (line >> token) {
+                const size_t dash = token.find('-');
+                int a, b;
+                if (dash == std::string::npos || !readHole(token.substr(0, dash), a) ||
+                        !readHole(token.substr(dash + 1), b))
+                    return fail(error, where + "bad edge '" + token + "', expected a-b");
+                description.edges.push_back(std::make_pair(a, b));
+            }
+        } else if (keyword == "line") {
+            std::vector<int> holes;
+            std::string token;
+            int hole;
+            while (line >> token) {
+                if (!readHole(token, hole))
+                    return fail(error, where + "bad hole '" + token + "'");
+                holes.push_back(hole);
+            }
+            description.lines.push_back(holes);
+        } else if (keyword == "perft") {
+            uint64_t nodes;
+            while (line >> nodes)
+                description.perft.push_back(nodes);
+            if (!line.eof())
+                return fail(error, where + "bad perft count");
+        } else if (keyword == "mode") {
+            if (!(line >> description.mode))
+                return fail(error, where + "expected 9 or 13");
+        } else {
+            return fail(error, where + "unknown keyword '" + keyword + "'");
+        }
+    }
+
+    return description.validate(error);
+}
+
+bool BoardDescription::load(const std::string& path, BoardDescription& description, std::string* error) {
+    std::ifstream in(path.c_str());
+    if (!in)
+        return fail(error, "cannot open " + path);
+
+    if (!BoardDescription::parse(in, description, error)) {
+        if (error)
+            *error = path + ": " + *error;
+        return false;
+    }
+    return true;
+}
+
+bool BoardDescription::validate(std::string* error) const {
+    if (holeCount < 1 || holeCount > MaxHoles)
+        return fail(error, "holes must be between 1 and " + std::to_string(MaxHoles));
+    if (piecesPerPlayer < 1 || 2 * piecesPerPlayer >= holeCount)
+        return fail(error, "pieces must leave at least one empty hole after the drop phase");
+    if (mode != 0 && mode != holeCount)
+        return fail(error, "mode must be 0 or equal to the number of holes");
+
+    // Vizinhanca sem lacos nem arestas repetidas, e grafo conexo.
+    std::set<std::pair<int, int> > seen;
+    std::vector<std::vector<int> > neighbours(holeCount);
+    for (const std::pair<int, int>& edge : edges) {
+        const int a = std::min(edge.first, edge.second);
+        const int b = std::max(edge.first, edge.second);
+        const std::string name = std::to_string(edge.first) + "-" + std::to_string(edge.second);
+        if (a < 0 || b >= holeCount)
+            return fail(error, "edge " + name + " refers to a hole that does not exist");
+        if (a == b)
+            return fail(error, "edge " + name + " connects a hole to itself");
+        if (!seen.insert(std::make_pair(a, b)).second)
+            return fail(error, "edge " + name + " is repeated");
+        neighbours[a].push_back(b);
+        neighbours[b].push_back(a);
+    }
+
+    std::vector<bool> reached(holeCount, false);
+    std::vector<int> stack(1, 0);
+    reached[0] = true;
+    int count = 1;
+    while (!stack.empty()) {
+        const int hole = stack.back();
+        stack.pop_back();
+        for (int next : neighbours[hole]) {
+            if (!reached[next]) {
+                reached[next] = true;
+                stack.push_back(next);
+                ++count;
+            }
+        }
+    }
+    if (count != holeCount)
+        return fail(error, "not every hole can be reached from hole 0");
+
+    // Uma linha de vitoria tem tantas casas quanto pecas por jogador.
+    if (lines.empty())
+        return fail(error, "at least one winning line is required");
+
+    std::set<std::vector<int> > distinct;
+    for (size_t i = 0; i < lines.size(); ++i) {
+        std::vector<int> line = lines[i];
+        const std::string name = "winning line " + std::to_string(i + 1);
+        if (static_cast<int>(line.size()) != piecesPerPlayer)
+            return fail(error, name + " must have exactly " + std::to_string(piecesPerPlayer) + " holes");
+
+        std::sort(line.begin(), line.end());
+        if (line.front() < 0 || line.back() >= holeCount)
+            return fail(error, name + " refers to a hole that does not exist");
+        if (std::adjacent_find(line.begin(), line.end()) != line.end())
+            return fail(error, name + " repeats a hole");
+        if (!distinct.insert(line).second)
+            return fail(error, name + " is repeated");
+    }
+
+    return true;
+}
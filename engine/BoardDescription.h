@@ -0,0 +1,45 @@
+#ifndef BOARDDESCRIPTION_H
+#define BOARDDESCRIPTION_H
+
+#include <cstdint>
+#include <istream>
+#include <string>
+#include <utility>
+#include <vector>
+
+// Tabuleiro descrito em texto, para variantes alem dos dois modos fixos.
+//
+//   # comentario
+//   name nove-casas
+//   holes 9
+//   pieces 3
+//   edges 0-1 1-2 0-3 ...     (uma ou mais linhas)
+//   line 0 1 2                (uma linha de vitoria por declaracao)
+//   perft 9 72 504            (opcional: contagens esperadas a partir da profundidade 1)
+//   mode 9                    (opcional: o mesmo tabuleiro de um modo de Board)
+//
+// As casas sao numeradas de 0 a holes - 1 e as arestas nao tem direcao.
+// Com 'mode', a casa i da descricao e a i-esima casa do modo em ordem
+// crescente, e Board::matches() confere que os dois tabuleiros sao iguais.
+struct BoardDescription {
+    static const int MaxHoles = 64;
+
+    std::string name;
+    int holeCount;
+    int piecesPerPlayer;
+    std::vector<std::pair<int, int> > edges;
+    std::vector<std::vector<int> > lines;
+    std::vector<uint64_t> perft;
+    int mode;               // 9, 13 ou 0 (variante sem modo correspondente)
+
+    BoardDescription() : holeCount(0), piecesPerPlayer(0), mode(0) {}
+
+    // Leem e conferem a descricao; em caso de erro, 'error' explica o motivo
+    // (com o numero da linha do texto quando for erro de sintaxe).
+    static bool parse(std::istream& in, BoardDescription& description, std::string* error = nullptr);
+    static bool load(const std::string& path, BoardDescription& description, std::string* error = nullptr);
+
+    bool validate(std::string* error = nullptr) const;
+};
+
+#endif // BOARDDESCRIPTION_H
@@ -0,0 +1,60 @@
+#include "DrawRules.h"
+
+#include <algorithm>
+
+DrawRules::DrawRules(int repetitions, int moveLimit)
+    : m_repetitions(repetitions),
+      m_moveLimit(moveLimit),
+      m_plies(0),
+      m_valid(0),
+      m_moveStart(-1) {
+}
+
+void DrawRules::reset(const Board& board) {
+    m_plies = 0;
+    m_hashes[0] = board.hash();
+    m_valid = 1;
+    m_moveStart = board.phase() == Board::MovePhase ? 0 : -1;
+}
+
+DrawRules::Verdict DrawRules::push(const Board& board) {
+    ++m_plies;
+    m_hashes[m_plies & (HistorySize - 1)] = board.hash();
+    m_valid = std::min(m_valid + 1, static_cast<int>(HistorySize));
+
+    if (board.phase() != Board::MovePhase)
+        return NoDraw;
+    if (m_moveStart < 0)
+        m_moveStart = m_plies;
+
+    // Na fase de colocar nenhuma posicao se repete; e a mesma vez de jogar
+    // so volta de dois em dois lances.
+    if (m_repetitions > 0) {
+        const int oldest = std::max(m_plies - m_valid + 1, m_moveStart);
+        const uint64_t key = board.hash();
+        int seen = 0;
+        for (int ply = m_plies; ply >= oldest; ply -= 2) {
+            if (m_hashes[ply & (HistorySize - 1)] == key && ++seen >= m_repetitions)
+                return Repetition;
+        }
+    }
+
+    if (m_moveLimit > 0 && this->movePlies() >= m_moveLimit)
+        return MoveLimit;
+
+    return NoDraw;
+}
+
+void DrawRules::pop() {
+    if (m_plies == 0)
+        return;
+
+    if (m_moveStart == m_plies)
+        m_moveStart = -1;
+    --m_plies;
+    m_valid = std::max(m_valid - 1, 0);
+}
+
+int DrawRules::movePlies() const {
+    return m_moveStart < 0 ? 0 : m_plies - m_moveStart;
+}
@@ -0,0 +1,52 @@
+#ifndef DRAWRULES_H
+#define DRAWRULES_H
+
+#include "Board.h"
+
+#include <cstdint>
+
+// Regras de empate de uma partida: repeticao da mesma posicao e limite de
+// lances na fase de mover. Guarda as chaves (Board::hash) das ultimas
+// HistorySize posicoes num anel, entao uma repeticao mais antiga que isso
+// nao e vista; o limite de lances garante o fim de qualquer forma.
+class DrawRules {
+public:
+    enum Verdict {
+        NoDraw,
+        Repetition,
+        MoveLimit
+    };
+
+    static const int HistorySize = 64;
+
+    // 0 desliga a regra correspondente.
+    explicit DrawRules(int repetitions = 3, int moveLimit = 0);
+
+    int repetitions() const { return m_repetitions; }
+    int moveLimit() const { return m_moveLimit; }
+    void setRepetitions(int repetitions) { m_repetitions = repetitions; }
+    void setMoveLimit(int moveLimit) { m_moveLimit = moveLimit; }
+
+    // Comeca uma partida na posicao 'board'.
+    void reset(const Board& board);
+
+    // Registra a posicao depois de uma jogada e diz se ela empata o jogo.
+    Verdict push(const Board& board);
+
+    // Esquece a ultima posicao registrada (para desfazer jogadas).
+    void pop();
+
+    // Lances feitos desde o inicio da fase de mover.
+    int movePlies() const;
+
+private:
+    int m_repetitions;
+    int m_moveLimit;
+
+    uint64_t m_hashes[HistorySize];
+    int m_plies;            // posicoes registradas depois da inicial
+    int m_valid;            // quantas das ultimas posicoes ainda estao no anel
+    int m_moveStart;        // lance em que a fase de mover comecou; -1 antes dela
+};
+
+#endif // DRAWRULES_H
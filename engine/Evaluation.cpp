@@ -0,0 +1,71 @@
+#include "Evaluation.h"
+
+namespace {
+
+// Ajustados com tools/evaltune sobre 300000 partidas aleatorias por modo
+// (trainingdata --label result).
+const Evaluation::Weights s_weights[2] = {
+    // NineHoles
+    { { 24, 2, 1, 13 } },
+    // ThirteenHoles
+    { { 19, 0, -2, 14 } }
+};
+
+const char* const s_featureNames[Evaluation::FeatureCount] = {
+    "threats",
+    "open-lines",
+    "mobility",
+    "centre"
+};
+
+void sideFeatures(const Topology& topology, Mask pieces, Mask other, int* values) {
+    for (int i = 0; i < topology.lineCount; ++i) {
+        const Mask line = topology.lines[i];
+        if (other & line)
+            continue;
+        const int count = bitCount(pieces & line);
+        values[Evaluation::OpenLines] += count > 0;
+        values[Evaluation::Threats] += count == 2;
+    }
+
+    const Mask empty = static_cast<Mask>(topology.holes & ~(pieces | other));
+    Mask remaining = pieces;
+    while (remaining)
+        values[Evaluation::Mobility] += bitCount(topology.adjacency[popLowestBit(remaining)] & empty);
+
+    values[Evaluation::Centre] += (pieces & holeBit(Evaluation::CentreHole)) != 0;
+}
+
+}
+
+const Evaluation::Weights& Evaluation::weights(Board::Mode mode) {
+    return s_weights[mode];
+}
+
+const char* Evaluation::featureName(Feature feature) {
+    return s_featureNames[feature];
+}
+
+void Evaluation::features(const Board& board, int* values) {
+    const Board::Player player = board.player();
+    Evaluation::features(board.topology(), board.pieces(player), board.pieces(Board::opponent(player)), values);
+}
+
+void Evaluation::features(const Topology& topology, Mask own, Mask other, int* values) {
+    int mine[FeatureCount] = { 0 };
+    int theirs[FeatureCount] = { 0 };
+    sideFeatures(topology, own, other, mine);
+    sideFeatures(topology, other, own, theirs);
+    for (int i = 0; i < FeatureCount; ++i)
+        values[i] = mine[i] - theirs[i];
+}
+
+int Evaluation::evaluate(const Board& board, const Weights& weights) {
+    int values[FeatureCount];
+    Evaluation::features(board, values);
+
+    int score = 0;
+    for (int i = 0; i < FeatureCount; ++i)
+        score += weights.values[i] * values[i];
+    return score;
+}
@@ -0,0 +1,39 @@
+#ifndef EVALUATION_H
+#define EVALUATION_H
+
+#include "Board.h"
+
+// Avaliacao estatica linear: soma de pesos vezes caracteristicas, cada uma
+// contada para quem joga menos a mesma contagem para o adversario.
+//
+// Os pesos de cada modo foram ajustados por tools/evaltune (metodo de
+// Texel) sobre resultados de partidas; o valor fica bem abaixo de
+// Search::WinThreshold para nao se confundir com vitorias.
+class Evaluation {
+public:
+    enum Feature {
+        Threats,        // linhas com duas pecas proprias e a terceira casa vazia
+        OpenLines,      // linhas com alguma peca propria e nenhuma do adversario
+        Mobility,       // passos para casas vizinhas vazias (vizinhanca da topologia)
+        Centre,         // peca na casa 6, a de mais vizinhos
+        FeatureCount
+    };
+
+    struct Weights {
+        int values[FeatureCount];
+    };
+
+    static const int CentreHole = 6;
+
+    static const Weights& weights(Board::Mode mode);
+    static const char* featureName(Feature feature);
+
+    // Caracteristicas do ponto de vista de quem joga.
+    static void features(const Board& board, int* values);
+    static void features(const Topology& topology, Mask own, Mask other, int* values);
+
+    static int evaluate(const Board& board) { return Evaluation::evaluate(board, Evaluation::weights(board.mode())); }
+    static int evaluate(const Board& board, const Weights& weights);
+};
+
+#endif // EVALUATION_H
@@ -0,0 +1,397 @@
+#include "Mcts.h"
+#include "Trace.h"
+
+#include <cmath>
+#include <thread>
+
+namespace {
+
+struct Node {
+    uint32_t firstChild;    // 0 = ainda nao expandido
+    uint32_t visits;
+    float score;            // do ponto de vista de quem fez a jogada que leva a este no
+    uint8_t move;
+    uint8_t childCount;
+    uint8_t terminal;       // quem fez a jogada venceu
+    uint8_t expanded;
+};
+
+class Arena {
+public:
+    explicit Arena(size_t capacity) : m_nodes(capacity), m_used(0) {}
+
+    void reset() { m_used = 0; }
+    size_t used() const { return m_used; }
+
+    // Devolve o indice do primeiro no ou 0 se a arena esta cheia.
+    uint32_t allocate(size_t count) {
+        if (m_used + count > m_nodes.size())
+            return 0;
+        uint32_t first = static_cast<uint32_t>(m_used);
+        m_used += count;
+        return first;
+    }
+
+    Node& operator[](uint32_t index) { return m_nodes[index]; }
+    const Node& operator[](uint32_t index) const { return m_nodes[index]; }
+
+private:
+    std::vector<Node> m_nodes;
+    size_t m_used;
+};
+
+class Random {
+public:
+    explicit Random(uint64_t seed) : m_state(seed ? seed : 1) {}
+
+    uint32_t next(uint32_t bound) {
+        m_state ^= m_state >> 12;
+        m_state ^= m_state << 25;
+        m_state ^= m_state >> 27;
+        return static_cast<uint32_t>(((m_state * 0x2545F4914F6CDD1Dull) >> 32) * bound >> 32);
+    }
+
+private:
+    uint64_t m_state;
+};
+
+}
+
+class Mcts::Tree {
+public:
+    Tree(size_t capacity, uint64_t seed)
+        : m_arenas { Arena(capacity), Arena(capacity) },
+          m_current(0),
+          m_rootKey(0),
+          m_random(seed),
+          m_playouts(0),
+          m_reused(0) {
+    }
+
+    void clear() {
+        this->arena().reset();
+        m_rootKey = 0;
+    }
+
+    void setRoot(const Board& board);
+    void search(const Limits& limits, std::chrono::steady_clock::time_point deadline,
+                const std::atomic<bool>& stopped);
+
+    uint64_t playouts() const { return m_playouts; }
+    uint64_t reused() const { return m_reused; }
+
+    // Visitas e pontuacao dos filhos da raiz, indexados por Move::bits().
+    void collect(uint64_t* visits, double* scores);
+
+private:
+    Arena m_arenas[2];
+    int m_current;
+    Board m_root;
+    uint64_t m_rootKey;
+    Random m_random;
+    uint64_t m_playouts;
+    uint64_t m_reused;
+
+    Arena& arena() { return m_arenas[m_current]; }
+
+    void iterate();
+    bool expand(uint32_t index, const Board& board);
+    float playout(Board board);
+    void reroot(uint32_t index);
+};
+
+void Mcts::Tree::setRoot(const Board& board) {
+    const uint64_t key = board.hash();
+    m_playouts = 0;
+
+    Arena& arena = this->arena();
+    bool reuse = arena.used() > 0 && key == m_rootKey;
+    if (!reuse && arena.used() > 0) {
+        // Procura a nova raiz entre os filhos e netos da raiz atual:
+        // a nossa jogada e a resposta do adversario.
+        uint32_t found = 0;
+        const Node& root = arena[0];
+        for (uint32_t i = 0; i < root.childCount && !found; ++i) {
+            const Node& node = arena[root.firstChild + i];
+            Board child(m_root);
+            child.play(Move::fromBits(node.move));
+            if (child.hash() == key) {
+                found = root.firstChild + i;
+                break;
+            }
+
+            for (uint32_t j = 0; j < node.childCount; ++j) {
+                Board grandchild(child);
+                grandchild.play(Move::fromBits(arena[node.firstChild + j].move));
+                if (grandchild.hash() == key) {
+                    found = node.firstChild + j;
+                    break;
+                }
+            }
+        }
+
+        if (found) {
+            this->reroot(found);
+            reuse = true;
+        }
+    }
+
+    if (!reuse) {
+        Arena& fresh = this->arena();
+        fresh.reset();
+        fresh.allocate(1);
+
+        Node& root = fresh[0];
+        root.firstChild = 0;
+        root.visits = 0;
+        root.score = 0;
+        root.move = Move().bits();
+        root.childCount = 0;
+        root.terminal = 0;
+        root.expanded = 0;
+    }
+
+    m_root = board;
+    m_rootKey = key;
+    m_reused = this->arena()[0].visits;
+}
+
+// Copia a subarvore de 'index' para a outra arena, em largura, mantendo
+// os filhos de cada no contiguos; o que nao couber fica sem expandir.
+void Mcts::Tree::reroot(uint32_t index) {
+    Arena& from = m_arenas[m_current];
+    Arena& to = m_arenas[1 - m_current];
+
+    to.reset();
+    to.allocate(1);
+    to[0] = from[index];
+
+    for (uint32_t i = 0; i < to.used(); ++i) {
+        Node& node = to[i];
+        if (!node.expanded || node.childCount == 0)
+            continue;
+
+        uint32_t first = to.allocate(node.childCount);
+        if (first == 0) {
+            node.expanded = 0;
+            node.childCount = 0;
+            node.firstChild = 0;
+            continue;
+        }
+
+        for (uint32_t j = 0; j < node.childCount; ++j)
+            to[first + j] = from[node.firstChild + j];
+        node.firstChild = first;
+    }
+
+    from.reset();
+    m_current = 1 - m_current;
+}
+
+bool Mcts::Tree::expand(uint32_t index, const Board& board) {
+    Move moves[Board::MaxMoves];
+    int count = board.generateMoves(moves);
+
+    Arena& arena = this->arena();
+    uint32_t first = count ? arena.allocate(count) : 0;
+    if (count && first == 0)
+        return false;
+
+    for (int i = 0; i < count; ++i) {
+        Board child(board);
+        child.play(moves[i]);
+
+        Node& node = arena[first + i];
+        node.firstChild = 0;
+        node.visits = 0;
+        node.score = 0;
+        node.move = moves[i].bits();
+        node.childCount = 0;
+        node.terminal = child.isWinningHole(board.player(), moves[i].to());
+        node.expanded = 0;
+    }
+
+    Node& node = arena[index];
+    node.firstChild = first;
+    node.childCount = static_cast<uint8_t>(count);
+    node.expanded = 1;
+    return true;
+}
+
+// Partida aleatoria; devolve o resultado para quem NAO joga em 'board',
+// ou seja, para quem fez a jogada que levou ate aqui.
+float Mcts::Tree::playout(Board board) {
+    const Board::Player mover = Board::opponent(board.player());
+
+    for (int ply = 0; ply < MaxPlayoutLength; ++ply) {
+        Move moves[Board::MaxMoves];
+        int count = board.generateMoves(moves);
+        if (count == 0)
+            return board.player() == mover ? 0.0f : 1.0f;
+
+        Move move = moves[m_random.next(count)];
+        Board::Player player = board.player();
+        board.play(move);
+        if (board.isWinningHole(player, move.to()))
+            return player == mover ? 1.0f : 0.0f;
+    }
+
+    return 0.5f;
+}
+
+void Mcts::Tree::iterate() {
+    static const float Exploration = 1.4f;
+
+    Arena& arena = this->arena();
+    uint32_t path[MaxPlayoutLength + 1];
+    int length = 0;
+
+    Board board(m_root);
+    uint32_t index = 0;
+    path[length++] = index;
+
+    float result;
+    for (;;) {
+        Node& node = arena[index];
+        if (node.terminal) {
+            result = 1.0f;
+            break;
+        }
+
+        if (!node.expanded) {
+            if ((node.visits == 0 && index != 0) || !this->expand(index, board)) {
+                result = this->playout(board);
+                break;
+            }
+        }
+
+        if (node.childCount == 0) {
+            // Quem joga esta bloqueado: vitoria de quem levou ate aqui.
+            result = 1.0f;
+            break;
+        }
+
+        const float logVisits = std::log(static_cast<float>(node.visits + 1));
+        uint32_t best = node.firstChild;
+        float bestValue = -1.0f;
+        for (uint32_t i = node.firstChild; i < node.firstChild + node.childCount; ++i) {
+            const Node& child = arena[i];
+            float value = child.visits == 0 ? 1e9f :
+                          child.score / child.visits + Exploration * std::sqrt(logVisits / child.visits);
+            if (value > bestValue) {
+                bestValue = value;
+                best = i;
+            }
+        }
+
+        board.play(Move::fromBits(arena[best].move));
+        index = best;
+        path[length++] = index;
+        if (length > MaxPlayoutLength) {
+            result = 0.5f;
+            break;
+        }
+    }
+
+    // O resultado vale para quem levou ao ultimo no; alterna na subida.
+    for (int i = length - 1; i >= 0; --i) {
+        Node& node = arena[path[i]];
+        ++node.visits;
+        node.score += result;
+        result = 1.0f - result;
+    }
+
+    ++m_playouts;
+}
+
+void Mcts::Tree::search(const Limits& limits, std::chrono::steady_clock::time_point deadline,
+                        const std::atomic<bool>& stopped) {
+    while (!stopped.load(std::memory_order_relaxed)) {
+        this->iterate();
+
+        if (limits.maxPlayouts && m_playouts >= limits.maxPlayouts)
+            break;
+        if ((m_playouts & 63) == 0) {
+            if (limits.maxTimeMs > 0 && std::chrono::steady_clock::now() >= deadline)
+                break;
+            if (limits.ticket && limits.ticket->load(std::memory_order_relaxed) != limits.ticketValue)
+                break;
+        }
+    }
+}
+
+void Mcts::Tree::collect(uint64_t* visits, double* scores) {
+    Arena& arena = this->arena();
+    const Node& root = arena[0];
+    for (uint32_t i = root.firstChild; i < root.firstChild + root.childCount; ++i) {
+        visits[arena[i].move] += arena[i].visits;
+        scores[arena[i].move] += arena[i].score;
+    }
+}
+
+Mcts::Mcts(size_t nodesPerThread)
+    : m_nodesPerThread(nodesPerThread),
+      m_threadCount(1),
+      m_stopped(false) {
+}
+
+Mcts::~Mcts() {
+}
+
+// As arvores so sao criadas em run(): quem nunca usa a busca nao paga as
+// arenas.
+void Mcts::setThreadCount(int count) {
+    m_threadCount = count < 1 ? 1 : count;
+}
+
+void Mcts::clear() {
+    for (size_t i = 0; i < m_trees.size(); ++i)
+        m_trees[i]->clear();
+}
+
+Mcts::Result Mcts::run(const Board& board, const Limits& limits) {
+    PICARIA_TRACE_SCOPE2("mcts", "threads", static_cast<int>(m_trees.size()), "maxPlayouts", static_cast<int64_t>(limits.maxPlayouts));
+    m_stopped.store(limits.ticket && limits.ticket->load() != limits.ticketValue, std::memory_order_relaxed);
+    const std::chrono::steady_clock::time_point deadline =
+            std::chrono::steady_clock::now() + std::chrono::milliseconds(limits.maxTimeMs);
+
+    m_trees.resize(m_threadCount);
+    for (size_t i = 0; i < m_trees.size(); ++i) {
+        if (!m_trees[i])
+            m_trees[i].reset(new Tree(m_nodesPerThread, 0x9E3779B97F4A7C15ull * (i + 1)));
+        m_trees[i]->setRoot(board);
+    }
+
+    std::vector<std::thread> helpers;
+    for (size_t i = 1; i < m_trees.size(); ++i) {
+        Tree* tree = m_trees[i].get();
+        helpers.push_back(std::thread([this, tree, &limits, deadline]() {
+            PICARIA_TRACE_THREAD("mcts helper");
+            tree->search(limits, deadline, m_stopped);
+        }));
+    }
+
+    m_trees[0]->search(limits, deadline, m_stopped);
+    for (size_t i = 0; i < helpers.size(); ++i)
+        helpers[i].join();
+
+    uint64_t visits[256] = { 0 };
+    double scores[256] = { 0 };
+    Result result;
+    for (size_t i = 0; i < m_trees.size(); ++i) {
+        m_trees[i]->collect(visits, scores);
+        result.playouts += m_trees[i]->playouts();
+        result.reused += m_trees[i]->reused();
+    }
+
+    uint64_t bestVisits = 0;
+    for (int bits = 0; bits < 256; ++bits) {
+        if (visits[bits] > bestVisits) {
+            bestVisits = visits[bits];
+            result.move = Move::fromBits(static_cast<uint8_t>(bits));
+            result.value = scores[bits] / visits[bits];
+        }
+    }
+
+    return result;
+}
@@ -0,0 +1,67 @@
+#ifndef MCTS_H
+#define MCTS_H
+
+#include "Board.h"
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+// Busca em arvore Monte Carlo (UCT) com partidas aleatorias.
+//
+// Os nos vem de uma arena contigua e sao referenciados por indice; nada e
+// liberado no a no. Para reaproveitar a arvore entre lances a subarvore da
+// nova raiz e copiada para uma segunda arena e as duas trocam de papel.
+// Com mais de uma thread cada uma tem sua propria arvore (paralelismo na
+// raiz) e as visitas dos filhos da raiz sao somadas no fim.
+class Mcts {
+public:
+    struct Limits {
+        Limits() : maxPlayouts(0), maxTimeMs(0), ticket(nullptr), ticketValue(0) {}
+
+        uint64_t maxPlayouts;   // 0 = sem limite (por thread)
+        int maxTimeMs;          // 0 = sem limite
+
+        // Como em Search::Limits: a busca vale enquanto *ticket == ticketValue.
+        const std::atomic<uint64_t>* ticket;
+        uint64_t ticketValue;
+    };
+
+    struct Result {
+        Result() : value(0), playouts(0), reused(0) {}
+
+        Move move;
+        double value;           // taxa de vitoria estimada da jogada escolhida
+        uint64_t playouts;      // soma de todas as threads
+        uint64_t reused;        // visitas herdadas da busca anterior
+    };
+
+    static const int MaxPlayoutLength = 200;
+
+    // O espaco de estados inteiro tem menos de 90000 posicoes.
+    explicit Mcts(size_t nodesPerThread = 1 << 16);
+    ~Mcts();
+
+    void setThreadCount(int count);
+    int threadCount() const { return m_threadCount; }
+
+    Result run(const Board& board, const Limits& limits);
+
+    // Pode ser chamado de outra thread enquanto run() executa.
+    void stop() { m_stopped.store(true, std::memory_order_relaxed); }
+
+    // Descarta as arvores de uma vez (nova partida).
+    void clear();
+
+private:
+    class Tree;
+
+    size_t m_nodesPerThread;
+    int m_threadCount;
+    std::vector<std::unique_ptr<Tree> > m_trees;    // criadas na primeira run()
+    std::atomic<bool> m_stopped;
+};
+
+#endif // MCTS_H
@@ -0,0 +1,34 @@
+#ifndef MOVE_H
+#define MOVE_H
+
+#include <cstdint>
+
+// Jogada compacta em um byte: nibble alto = origem, nibble baixo = destino.
+// Uma colocacao (fase de colocar) usa a origem NoHole.
+class Move {
+public:
+    static const int NoHole = 0xF;
+
+    Move() : m_bits(0xFF) {}
+
+    static Move drop(int to) { return Move(static_cast<uint8_t>((NoHole << 4) | to)); }
+    static Move step(int from, int to) { return Move(static_cast<uint8_t>((from << 4) | to)); }
+    static Move fromBits(uint8_t bits) { return Move(bits); }
+
+    int from() const { return m_bits >> 4; }
+    int to() const { return m_bits & 0xF; }
+    uint8_t bits() const { return m_bits; }
+
+    bool isNull() const { return m_bits == 0xFF; }
+    bool isDrop() const { return from() == NoHole && !isNull(); }
+
+    bool operator==(const Move& other) const { return m_bits == other.m_bits; }
+    bool operator!=(const Move& other) const { return m_bits != other.m_bits; }
+
+private:
+    explicit Move(uint8_t bits) : m_bits(bits) {}
+
+    uint8_t m_bits;
+};
+
+#endif // MOVE_H
@@ -0,0 +1,43 @@
+#ifndef MOVEHISTORY_H
+#define MOVEHISTORY_H
+
+#include "Move.h"
+
+// Pilha de jogadas de tamanho fixo (um byte por jogada) com desfazer e
+// refazer em tempo constante. Quando enche, as jogadas mais antigas sao
+// descartadas; uma jogada nova apaga o que havia para refazer.
+class MoveHistory {
+public:
+    static const int Capacity = 1024;
+
+    MoveHistory() : m_first(0), m_current(0), m_last(0) {}
+
+    void clear() { m_first = m_current = m_last = 0; }
+
+    void push(Move move) {
+        m_moves[m_current++ & (Capacity - 1)] = move;
+        m_last = m_current;
+        if (m_current - m_first > Capacity)
+            m_first = m_current - Capacity;
+    }
+
+    bool canUndo() const { return m_current > m_first; }
+    bool canRedo() const { return m_current < m_last; }
+
+    // Jogada a desfazer (a ultima feita) e jogada a refazer (a proxima).
+    Move undo() { return m_moves[--m_current & (Capacity - 1)]; }
+    Move redo() { return m_moves[m_current++ & (Capacity - 1)]; }
+
+    int undoCount() const { return m_current - m_first; }
+    int redoCount() const { return m_last - m_current; }
+
+private:
+    Move m_moves[Capacity];
+
+    // Contadores absolutos; o indice no anel e o contador mascarado.
+    int m_first;
+    int m_current;
+    int m_last;
+};
+
+#endif // MOVEHISTORY_H
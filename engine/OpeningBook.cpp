@@ -0,0 +1,85 @@
+#include "OpeningBook.h"
+#include "Symmetry.h"
+
+#include <algorithm>
+#include <cstring>
+
+static const char s_magic[4] = { 'P', 'C', 'O', 'B' };
+
+static_assert(sizeof(OpeningBook::Header) == 12 && sizeof(OpeningBook::Entry) == 8,
+              "OpeningBook file layout must not depend on padding");
+
+OpeningBook::OpeningBook()
+    : m_mode(Board::NineHoles),
+      m_entries(nullptr),
+      m_count(0) {
+}
+
+bool OpeningBook::attach(const void* data, size_t size, Board::Mode mode) {
+    this->detach();
+    if (data == nullptr || size < sizeof(Header))
+        return false;
+
+    Header header;
+    std::memcpy(&header, data, sizeof(header));
+    if (std::memcmp(header.magic, s_magic, sizeof(s_magic)) != 0 || header.version != Version ||
+            header.mode != mode || size != sizeof(Header) + header.count * sizeof(Entry))
+        return false;
+
+    m_mode = mode;
+    m_entries = reinterpret_cast<const Entry*>(static_cast<const char*>(data) + sizeof(Header));
+    m_count = static_cast<int>(header.count);
+    return true;
+}
+
+void OpeningBook::detach() {
+    m_entries = nullptr;
+    m_count = 0;
+}
+
+bool OpeningBook::covers(const Board& board) const {
+    return m_entries != nullptr && board.mode() == m_mode && board.phase() == Board::DropPhase;
+}
+
+const OpeningBook::Entry* OpeningBook::lookup(uint32_t key) const {
+    const Entry* end = m_entries + m_count;
+    const Entry* entry = std::lower_bound(m_entries, end, key,
+        [](const Entry& entry, uint32_t key) { return entry.key < key; });
+
+    return entry != end && entry->key == key ? entry : nullptr;
+}
+
+const OpeningBook::Entry* OpeningBook::find(const Board& board) const {
+    return this->covers(board) ? this->lookup(Symmetry::canonicalKey(board)) : nullptr;
+}
+
+Move OpeningBook::probe(const Board& board, Tablebase::Result* result, int* distance) const {
+    if (!this->covers(board))
+        return Move();
+
+    Symmetry::Transform transform;
+    const Entry* entry = this->lookup(Symmetry::canonicalKey(board, &transform));
+    if (entry == nullptr)
+        return Move();
+
+    if (result)
+        *result = static_cast<Tablebase::Result>(entry->result);
+    if (distance)
+        *distance = entry->distance;
+
+    return Symmetry::toOriginal(transform, Move::fromBits(entry->move));
+}
+
+OpeningBook::Header OpeningBook::makeHeader(Board::Mode mode, uint32_t count) {
+    Header header;
+    std::memcpy(header.magic, s_magic, sizeof(s_magic));
+    header.mode = static_cast<uint8_t>(mode);
+    header.version = Version;
+    header.reserved = 0;
+    header.count = count;
+    return header;
+}
+
+const char* OpeningBook::fileName(Board::Mode mode) {
+    return mode == Board::NineHoles ? "picaria-9.book" : "picaria-13.book";
+}
@@ -0,0 +1,60 @@
+#ifndef OPENINGBOOK_H
+#define OPENINGBOOK_H
+
+#include "Board.h"
+#include "Tablebase.h"
+
+#include <cstddef>
+
+// Livro de aberturas da fase de colocar (dropCount < 6) de um modo.
+//
+// Formato do arquivo (little-endian): um OpeningBook::Header seguido de
+// 'count' entradas ordenadas pela chave canonica de Symmetry::canonicalKey,
+// de modo que a consulta e uma busca binaria direto no arquivo mapeado.
+// A jogada de cada entrada vale para a posicao canonica.
+class OpeningBook {
+public:
+    struct Header {
+        char magic[4];
+        uint8_t mode;
+        uint8_t version;
+        uint16_t reserved;
+        uint32_t count;
+    };
+
+    struct Entry {
+        uint32_t key;
+        uint8_t move;
+        uint8_t result;     // Tablebase::Result do ponto de vista de quem joga
+        uint16_t distance;  // lances ate o fim; 0 quando o resultado e empate
+    };
+
+    static const uint8_t Version = 1;
+
+    OpeningBook();
+
+    // Como no Tablebase, os dados nao sao copiados.
+    bool attach(const void* data, size_t size, Board::Mode mode);
+    void detach();
+    bool isValid() const { return m_entries != nullptr; }
+
+    int count() const { return m_count; }
+    const Entry* find(const Board& board) const;
+
+    // Jogada do livro ja levada para a orientacao de 'board'; nula se a
+    // posicao nao estiver no livro.
+    Move probe(const Board& board, Tablebase::Result* result = nullptr, int* distance = nullptr) const;
+
+    static Header makeHeader(Board::Mode mode, uint32_t count);
+    static const char* fileName(Board::Mode mode);
+
+private:
+    Board::Mode m_mode;
+    const Entry* m_entries;
+    int m_count;
+
+    bool covers(const Board& board) const;
+    const Entry* lookup(uint32_t key) const;
+};
+
+#endif // OPENINGBOOK_H
@@ -0,0 +1,145 @@
+#include "PositionIndex.h"
+
+#include <cassert>
+
+namespace {
+
+const int HoleCount = Board::HoleCount;
+
+// Segmentos na ordem em que as posicoes aparecem numa partida.
+struct Segment {
+    int red;
+    int blue;
+    Board::Player player;
+    int offset;
+    int blueCount;
+};
+
+const int SegmentCount = 8;
+
+Segment s_segments[SegmentCount] = {
+    { 0, 0, Board::RedPlayer, 0, 0 },
+    { 1, 0, Board::BluePlayer, 0, 0 },
+    { 1, 1, Board::RedPlayer, 0, 0 },
+    { 2, 1, Board::BluePlayer, 0, 0 },
+    { 2, 2, Board::RedPlayer, 0, 0 },
+    { 3, 2, Board::BluePlayer, 0, 0 },
+    { 3, 3, Board::RedPlayer, 0, 0 },
+    { 3, 3, Board::BluePlayer, 0, 0 }
+};
+
+int s_binomial[HoleCount + 1][4];
+
+struct Tables {
+    Tables() {
+        for (int n = 0; n <= HoleCount; ++n) {
+            s_binomial[n][0] = 1;
+            for (int k = 1; k < 4; ++k)
+                s_binomial[n][k] = n == 0 ? 0 : s_binomial[n - 1][k - 1] + s_binomial[n - 1][k];
+        }
+
+        int offset = 0;
+        for (int i = 0; i < SegmentCount; ++i) {
+            Segment& segment = s_segments[i];
+            segment.offset = offset;
+            segment.blueCount = s_binomial[HoleCount - segment.red][segment.blue];
+            offset += s_binomial[HoleCount][segment.red] * segment.blueCount;
+        }
+        assert(offset == PositionIndex::Size);
+    }
+};
+
+const Tables s_tables;
+
+int segmentOf(int red, int blue, Board::Player player) {
+    switch (red + blue) {
+        case 0: case 1: case 2: case 3: case 4: case 5:
+            return red + blue;
+        default:
+            return player == Board::RedPlayer ? 6 : 7;
+    }
+}
+
+// Posicao colex do conjunto de bits dentro dos subconjuntos do mesmo tamanho.
+int rank(uint32_t set) {
+    int result = 0;
+    for (int k = 1; set; ++k) {
+        int id = lowestBit(set);
+        set &= set - 1;
+        result += s_binomial[id][k];
+    }
+    return result;
+}
+
+uint32_t unrank(int rank, int k, int n) {
+    uint32_t set = 0;
+    for (; k > 0; --k) {
+        int id = n - 1;
+        while (s_binomial[id][k] > rank)
+            --id;
+        rank -= s_binomial[id][k];
+        set |= 1u << id;
+        n = id;
+    }
+    return set;
+}
+
+// Remove os bits de 'holes' de 'set', compactando os demais para baixo.
+uint32_t compress(uint32_t set, uint32_t holes) {
+    uint32_t result = 0;
+    int bit = 0;
+    for (int id = 0; id < HoleCount; ++id) {
+        if (holes & (1u << id))
+            continue;
+        if (set & (1u << id))
+            result |= 1u << bit;
+        ++bit;
+    }
+    return result;
+}
+
+uint32_t expand(uint32_t set, uint32_t holes) {
+    uint32_t result = 0;
+    int bit = 0;
+    for (int id = 0; id < HoleCount; ++id) {
+        if (holes & (1u << id))
+            continue;
+        if (set & (1u << bit))
+            result |= 1u << id;
+        ++bit;
+    }
+    return result;
+}
+
+}
+
+int PositionIndex::index(const Board& board) {
+    return PositionIndex::index(board.pieces(Board::RedPlayer), board.pieces(Board::BluePlayer),
+                                board.player());
+}
+
+int PositionIndex::index(Mask red, Mask blue, Board::Player player) {
+    const Segment& segment = s_segments[segmentOf(bitCount(red), bitCount(blue), player)];
+    assert(segment.red == bitCount(red) && segment.blue == bitCount(blue) && segment.player == player);
+
+    return segment.offset + rank(red) * segment.blueCount + rank(compress(blue, red));
+}
+
+bool PositionIndex::position(int index, Board& board) {
+    assert(index >= 0 && index < PositionIndex::Size);
+
+    int i = SegmentCount - 1;
+    while (s_segments[i].offset > index)
+        --i;
+
+    const Segment& segment = s_segments[i];
+    int local = index - segment.offset;
+    uint32_t red = unrank(local / segment.blueCount, segment.red, HoleCount);
+    uint32_t blue = expand(unrank(local % segment.blueCount, segment.blue, HoleCount - segment.red), red);
+
+    if ((red | blue) & ~board.holes())
+        return false;
+
+    board.setPosition(static_cast<Mask>(red), static_cast<Mask>(blue), segment.player);
+    return true;
+}
@@ -0,0 +1,21 @@
+#ifndef POSITIONINDEX_H
+#define POSITIONINDEX_H
+
+#include "Board.h"
+
+// Numeracao densa de todas as posicoes com pecas validas para a vez:
+// as contagens de pecas (vermelho, azul) e a vez definem um segmento e,
+// dentro dele, os conjuntos de casas sao ordenados pelo sistema
+// combinatorio. A numeracao usa as 13 casas nos dois modos.
+class PositionIndex {
+public:
+    static const int Size = 86828;
+
+    static int index(const Board& board);
+    static int index(Mask red, Mask blue, Board::Player player);
+
+    // Inverso de index(); devolve false se a posicao nao cabe no modo.
+    static bool position(int index, Board& board);
+};
+
+#endif // POSITIONINDEX_H
@@ -0,0 +1,234 @@
+#include "Search.h"
+#include "Evaluation.h"
+#include "Trace.h"
+
+#include <algorithm>
+#include <cstring>
+#include <thread>
+#include <vector>
+
+Search::Worker::Worker()
+    : nodes(0),
+      reportedNodes(0) {
+    std::memset(history, 0, sizeof(history));
+}
+
+Search::Search(size_t hashMegabytes)
+    : m_table(hashMegabytes),
+      m_threadCount(1),
+      m_stopped(false),
+      m_nodes(0) {
+}
+
+void Search::setThreadCount(int count) {
+    m_threadCount = std::max(1, count);
+}
+
+void Search::clear() {
+    m_table.clear();
+}
+
+Search::Result Search::run(const Board& board, const Limits& limits) {
+    PICARIA_TRACE_SCOPE2("search", "threads", m_threadCount, "maxDepth", limits.maxDepth);
+    m_limits = limits;
+    m_nodes.store(0, std::memory_order_relaxed);
+    // Ja abandonada: sai na primeira profundidade, que ainda da uma jogada.
+    m_stopped.store(limits.ticket && limits.ticket->load() != limits.ticketValue, std::memory_order_relaxed);
+    if (limits.maxTimeMs > 0)
+        m_deadline = Clock::now() + std::chrono::milliseconds(limits.maxTimeMs);
+
+    std::vector<Worker> workers(m_threadCount);
+    std::vector<std::thread> helpers;
+    for (int i = 1; i < m_threadCount; ++i) {
+        // Metade das auxiliares comeca uma profundidade a frente.
+        helpers.push_back(std::thread([this, &workers, &board, i]() {
+            PICARIA_TRACE_THREAD("search helper");
+            this->iterate(workers[i], board, 1 + (i & 1), 1);
+        }));
+    }
+
+    Result result = this->iterate(workers[0], board, 1, 1);
+
+    m_stopped.store(true, std::memory_order_relaxed);
+    for (size_t i = 0; i < helpers.size(); ++i)
+        helpers[i].join();
+
+    result.nodes = 0;
+    for (size_t i = 0; i < workers.size(); ++i)
+        result.nodes += workers[i].nodes;
+
+    return result;
+}
+
+Search::Result Search::iterate(Worker& worker, const Board& board, int firstDepth, int step) {
+    Result result;
+    Board position(board);
+    const int maxDepth = std::min(m_limits.maxDepth, static_cast<int>(MaxDepth));
+
+    for (int depth = firstDepth; depth <= maxDepth; depth += step) {
+        PICARIA_TRACE_SCOPE1("search.depth", "depth", depth);
+        Move best;
+        int score = this->negamax(worker, position, depth, -WinScore, WinScore, 0, &best);
+        if (m_stopped.load(std::memory_order_relaxed) && !result.move.isNull())
+            break;
+
+        result.move = best;
+        result.score = score;
+        result.depth = depth;
+
+        // Resultado forcado: aprofundar nao muda mais nada.
+        if (score >= WinThreshold || score <= -WinThreshold)
+            break;
+    }
+
+    return result;
+}
+
+bool Search::shouldStop(Worker& worker) {
+    if (m_stopped.load(std::memory_order_relaxed))
+        return true;
+
+    if ((worker.nodes & 1023) == 0) {
+        if (m_limits.ticket && m_limits.ticket->load(std::memory_order_relaxed) != m_limits.ticketValue)
+            m_stopped.store(true, std::memory_order_relaxed);
+
+        uint64_t nodes = m_nodes.fetch_add(worker.nodes - worker.reportedNodes, std::memory_order_relaxed) +
+                         worker.nodes - worker.reportedNodes;
+        worker.reportedNodes = worker.nodes;
+
+        if ((m_limits.maxNodes && nodes >= m_limits.maxNodes) ||
+                (m_limits.maxTimeMs > 0 && Clock::now() >= m_deadline))
+            m_stopped.store(true, std::memory_order_relaxed);
+    }
+
+    return m_stopped.load(std::memory_order_relaxed);
+}
+
+int Search::principalVariation(const Board& board, Move* moves, int maxLength) const {
+    Board position(board);
+    int length = 0;
+    TranspositionTable::Entry entry;
+    while (length < maxLength && m_table.probe(position.hash(), entry) && position.isLegal(entry.move)) {
+        const Board::Player player = position.player();
+        moves[length++] = entry.move;
+        position.play(entry.move);
+        if (position.isWinningHole(player, entry.move.to()))
+            break;
+    }
+    return length;
+}
+
+// Folhas que nao terminaram a partida: avaliacao linear ajustada por modo.
+int Search::evaluate(const Board& board) {
+    return Evaluation::evaluate(board);
+}
+
+// Jogada da tabela primeiro, depois pela tabela de historico.
+void Search::orderMoves(const Worker& worker, Move* moves, int count, Move first) {
+    int scores[Board::MaxMoves];
+    for (int i = 0; i < count; ++i) {
+        int from = moves[i].isDrop() ? Board::HoleCount : moves[i].from();
+        scores[i] = moves[i] == first ? 1 << 30 : worker.history[from][moves[i].to()];
+    }
+
+    for (int i = 1; i < count; ++i) {
+        Move move = moves[i];
+        int score = scores[i];
+        int j = i - 1;
+        for (; j >= 0 && scores[j] < score; --j) {
+            moves[j + 1] = moves[j];
+            scores[j + 1] = scores[j];
+        }
+        moves[j + 1] = move;
+        scores[j + 1] = score;
+    }
+}
+
+// Faz e desfaz as jogadas no proprio tabuleiro em vez de copia-lo por filho.
+int Search::negamax(Worker& worker, Board& board, int depth,
+                    int alpha, int beta, int ply, Move* best) {
+    ++worker.nodes;
+    if (ply > 0 && this->shouldStop(worker))
+        return 0;
+
+    Move moves[Board::MaxMoves];
+    int count = board.generateMoves(moves);
+    if (count == 0)
+        return -WinScore + ply;
+
+    if (depth <= 0)
+        return Search::evaluate(board);
+
+    const int originalAlpha = alpha;
+    const uint64_t key = board.hash();
+    Move tableMove;
+    TranspositionTable::Entry entry;
+    if (m_table.probe(key, entry)) {
+        if (board.isLegal(entry.move))
+            tableMove = entry.move;
+
+        int score = entry.score;
+        if (score >= WinThreshold)
+            score -= ply;
+        else if (score <= -WinThreshold)
+            score += ply;
+
+        if (ply > 0 && entry.depth >= depth) {
+            if (entry.bound == TranspositionTable::ExactBound ||
+                    (entry.bound == TranspositionTable::LowerBound && score >= beta) ||
+                    (entry.bound == TranspositionTable::UpperBound && score <= alpha))
+                return score;
+        }
+    }
+
+    Search::orderMoves(worker, moves, count, tableMove);
+
+    const Board::Player player = board.player();
+    int bestScore = -WinScore - 1;
+    Move bestMove = moves[0];
+    for (int i = 0; i < count; ++i) {
+        board.play(moves[i]);
+
+        int score;
+        if (board.isWinningHole(player, moves[i].to()))
+            score = WinScore - ply - 1;
+        else
+            score = -this->negamax(worker, board, depth - 1, -beta, -alpha, ply + 1, nullptr);
+
+        board.unplay(moves[i]);
+
+        if (m_stopped.load(std::memory_order_relaxed))
+            break;
+
+        if (score > bestScore) {
+            bestScore = score;
+            bestMove = moves[i];
+        }
+        if (score > alpha)
+            alpha = score;
+        if (alpha >= beta) {
+            int from = moves[i].isDrop() ? Board::HoleCount : moves[i].from();
+            worker.history[from][moves[i].to()] += depth * depth;
+            break;
+        }
+    }
+
+    if (best)
+        *best = bestMove;
+
+    if (m_stopped.load(std::memory_order_relaxed))
+        return bestScore;
+
+    TranspositionTable::Bound bound = bestScore <= originalAlpha ? TranspositionTable::UpperBound :
+                                      bestScore >= beta ? TranspositionTable::LowerBound :
+                                      TranspositionTable::ExactBound;
+
+    int stored = bestScore;
+    if (stored >= WinThreshold)
+        stored += ply;
+    else if (stored <= -WinThreshold)
+        stored -= ply;
+
+    m_table.store(key, stored, depth, bound, bestMove);
+    return bestScore;
+}
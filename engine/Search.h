@@ -0,0 +1,89 @@
+#ifndef SEARCH_H
+#define SEARCH_H
+
+#include "Board.h"
+#include "TranspositionTable.h"
+
+#include <atomic>
+#include <chrono>
+
+// Negamax com poda alfa-beta, aprofundamento iterativo e tabela de transposicao.
+//
+// Com mais de uma thread a busca usa Lazy SMP: as threads auxiliares buscam
+// a mesma raiz em profundidades intercaladas e so se comunicam pela tabela
+// de transposicao compartilhada; o resultado e o da thread principal.
+class Search {
+public:
+    static const int WinScore = 10000;
+    static const int WinThreshold = WinScore - 1000;
+    static const int MaxDepth = 64;
+
+    struct Limits {
+        Limits() : maxDepth(MaxDepth), maxNodes(0), maxTimeMs(0), ticket(nullptr), ticketValue(0) {}
+
+        int maxDepth;
+        uint64_t maxNodes;      // 0 = sem limite
+        int maxTimeMs;          // 0 = sem limite
+
+        // Busca valida enquanto *ticket == ticketValue. Quem pediu a busca a
+        // abandona trocando o valor, mesmo antes de run() comecar; ao
+        // contrario de stop(), nada disso e apagado no inicio de run().
+        const std::atomic<uint64_t>* ticket;
+        uint64_t ticketValue;
+    };
+
+    struct Result {
+        Result() : score(0), depth(0), nodes(0) {}
+
+        Move move;
+        int score;              // do ponto de vista de quem joga
+        int depth;              // ultima iteracao completa
+        uint64_t nodes;         // soma de todas as threads
+    };
+
+    explicit Search(size_t hashMegabytes = 16);
+
+    void setThreadCount(int count);
+    int threadCount() const { return m_threadCount; }
+
+    Result run(const Board& board, const Limits& limits);
+
+    // Pode ser chamado de outra thread enquanto run() executa.
+    void stop() { m_stopped.store(true, std::memory_order_relaxed); }
+
+    void clear();
+
+    // Variante principal a partir de board, seguindo as jogadas guardadas
+    // na tabela de transposicao. Retorna quantas jogadas escreveu.
+    int principalVariation(const Board& board, Move* moves, int maxLength) const;
+
+private:
+    typedef std::chrono::steady_clock Clock;
+
+    // Estado de cada thread da busca.
+    struct Worker {
+        Worker();
+
+        int history[Board::HoleCount + 1][Board::HoleCount];   // [origem ou colocacao][destino]
+        uint64_t nodes;
+        uint64_t reportedNodes;
+    };
+
+    TranspositionTable m_table;
+    int m_threadCount;
+    std::atomic<bool> m_stopped;
+    std::atomic<uint64_t> m_nodes;
+
+    Limits m_limits;
+    Clock::time_point m_deadline;
+
+    Result iterate(Worker& worker, const Board& board, int firstDepth, int step);
+    int negamax(Worker& worker, Board& board, int depth,
+                int alpha, int beta, int ply, Move* best);
+    bool shouldStop(Worker& worker);
+
+    static void orderMoves(const Worker& worker, Move* moves, int count, Move first);
+    static int evaluate(const Board& board);
+};
+
+#endif // SEARCH_H
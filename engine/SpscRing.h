@@ -0,0 +1,58 @@
+#ifndef SPSCRING_H
+#define SPSCRING_H
+
+#include <atomic>
+#include <cstddef>
+
+// Fila circular sem travas para exatamente um produtor e um consumidor.
+// Nenhum dos lados espera: push() falha com a fila cheia e pop() com ela
+// vazia. Cada indice so e escrito por um lado, em linhas de cache separadas.
+template <typename T, size_t Capacity>
+class SpscRing {
+    static_assert(Capacity >= 2 && (Capacity & (Capacity - 1)) == 0, "SpscRing capacity must be a power of two");
+
+public:
+    SpscRing() : m_head(0), m_tail(0) {}
+
+    // Produtor.
+    bool push(const T& value) {
+        const size_t tail = m_tail.load(std::memory_order_relaxed);
+        if (tail - m_head.load(std::memory_order_acquire) == Capacity)
+            return false;
+
+        m_items[tail & (Capacity - 1)] = value;
+        m_tail.store(tail + 1, std::memory_order_release);
+        return true;
+    }
+
+    // Consumidor.
+    bool pop(T& value) {
+        const size_t head = m_head.load(std::memory_order_relaxed);
+        if (head == m_tail.load(std::memory_order_acquire))
+            return false;
+
+        value = m_items[head & (Capacity - 1)];
+        m_head.store(head + 1, std::memory_order_release);
+        return true;
+    }
+
+    bool empty() const {
+        return m_head.load(std::memory_order_acquire) == m_tail.load(std::memory_order_acquire);
+    }
+
+private:
+    SpscRing(const SpscRing&);
+    SpscRing& operator=(const SpscRing&);
+
+    // Preenchimento em vez de alignas: o objeto pode vir de um new, que
+    // antes do C++17 nao respeita alinhamentos maiores.
+    static const size_t CacheLine = 64;
+
+    std::atomic<size_t> m_head;     // proximo a ler
+    char m_headPadding[CacheLine - sizeof(std::atomic<size_t>)];
+    std::atomic<size_t> m_tail;     // proximo a escrever
+    char m_tailPadding[CacheLine - sizeof(std::atomic<size_t>)];
+    T m_items[Capacity];
+};
+
+#endif // SPSCRING_H
@@ -0,0 +1,142 @@
+#include "Symmetry.h"
+
+#include <cassert>
+
+namespace {
+
+// Coordenadas das casas numa grade 5x5 com centro (2, 2).
+const int s_coordinates[Board::HoleCount][2] = {
+    { 0, 0 }, { 2, 0 }, { 4, 0 },
+        { 1, 1 }, { 3, 1 },
+    { 0, 2 }, { 2, 2 }, { 4, 2 },
+        { 1, 3 }, { 3, 3 },
+    { 0, 4 }, { 2, 4 }, { 4, 4 }
+};
+
+void transformPoint(int transform, int x, int y, int& tx, int& ty) {
+    switch (transform) {
+        case Symmetry::Identity:         tx = x;     ty = y;     break;
+        case Symmetry::Rotate90:         tx = 4 - y; ty = x;     break;
+        case Symmetry::Rotate180:        tx = 4 - x; ty = 4 - y; break;
+        case Symmetry::Rotate270:        tx = y;     ty = 4 - x; break;
+        case Symmetry::FlipHorizontal:   tx = 4 - x; ty = y;     break;
+        case Symmetry::FlipVertical:     tx = x;     ty = 4 - y; break;
+        case Symmetry::FlipDiagonal:     tx = y;     ty = x;     break;
+        default:                         tx = 4 - y; ty = 4 - x; break;
+    }
+}
+
+int holeAt(int x, int y) {
+    for (int id = 0; id < Board::HoleCount; ++id) {
+        if (s_coordinates[id][0] == x && s_coordinates[id][1] == y)
+            return id;
+    }
+    return -1;
+}
+
+}
+
+const Symmetry::Tables Symmetry::s_tables;
+
+Symmetry::Tables::Tables() {
+    for (int t = 0; t < TransformCount; ++t) {
+        for (int id = 0; id < Board::HoleCount; ++id) {
+            int x, y;
+            transformPoint(t, s_coordinates[id][0], s_coordinates[id][1], x, y);
+            holes[t][id] = static_cast<int8_t>(holeAt(x, y));
+            assert(holes[t][id] >= 0);
+        }
+
+        for (int byte = 0; byte < 256; ++byte) {
+            Mask mask = 0;
+            for (int bit = 0; bit < 8; ++bit) {
+                if (byte & (1 << bit))
+                    mask |= holeBit(holes[t][bit]);
+            }
+            low[t][byte] = mask;
+        }
+
+        for (int bits = 0; bits < (1 << (Board::HoleCount - 8)); ++bits) {
+            Mask mask = 0;
+            for (int bit = 0; bit < Board::HoleCount - 8; ++bit) {
+                if (bits & (1 << bit))
+                    mask |= holeBit(holes[t][bit + 8]);
+            }
+            high[t][bits] = mask;
+        }
+    }
+
+    for (int t = 0; t < TransformCount; ++t) {
+        for (int u = 0; u < TransformCount; ++u) {
+            if (holes[u][holes[t][0]] == 0 && holes[u][holes[t][1]] == 1 && holes[u][holes[t][3]] == 3)
+                inverse[t] = static_cast<Transform>(u);
+        }
+    }
+
+#ifndef NDEBUG
+    const Topology* topologies[] = { &Topology::nineHoles(), &Topology::thirteenHoles() };
+    for (const Topology* topology : topologies) {
+        for (int t = 0; t < TransformCount; ++t) {
+            assert((low[t][topology->holes & 0xFF] | high[t][topology->holes >> 8]) == topology->holes);
+            for (int id = 0; id < Board::HoleCount; ++id) {
+                Mask adjacency = topology->adjacency[id];
+                Mask image = static_cast<Mask>(low[t][adjacency & 0xFF] | high[t][adjacency >> 8]);
+                assert(image == topology->adjacency[holes[t][id]]);
+            }
+            for (int line = 0; line < topology->lineCount; ++line) {
+                Mask mask = topology->lines[line];
+                Mask image = static_cast<Mask>(low[t][mask & 0xFF] | high[t][mask >> 8]);
+                bool found = false;
+                for (int other = 0; other < topology->lineCount; ++other)
+                    found = found || topology->lines[other] == image;
+                assert(found);
+            }
+        }
+    }
+#endif
+}
+
+Move Symmetry::apply(Transform transform, Move move) {
+    if (move.isNull())
+        return move;
+
+    if (move.isDrop())
+        return Move::drop(Symmetry::apply(transform, move.to()));
+
+    return Move::step(Symmetry::apply(transform, move.from()), Symmetry::apply(transform, move.to()));
+}
+
+Board Symmetry::apply(Transform transform, const Board& board) {
+    Board image(board.mode());
+    image.setPosition(Symmetry::apply(transform, board.pieces(Board::RedPlayer)),
+                      Symmetry::apply(transform, board.pieces(Board::BluePlayer)),
+                      board.player());
+    return image;
+}
+
+uint32_t Symmetry::canonicalKey(const Board& board, Transform* transform) {
+    const Mask red = board.pieces(Board::RedPlayer);
+    const Mask blue = board.pieces(Board::BluePlayer);
+
+    uint32_t best = static_cast<uint32_t>(red) << 16 | blue;
+    Transform bestTransform = Identity;
+    for (int t = 1; t < TransformCount; ++t) {
+        uint32_t key = static_cast<uint32_t>(Symmetry::apply(static_cast<Transform>(t), red)) << 16 |
+                       Symmetry::apply(static_cast<Transform>(t), blue);
+        if (key < best) {
+            best = key;
+            bestTransform = static_cast<Transform>(t);
+        }
+    }
+
+    if (transform)
+        *transform = bestTransform;
+    return best;
+}
+
+Symmetry::Transform Symmetry::canonicalize(const Board& board, Board& canonical) {
+    Transform transform;
+    Symmetry::canonicalKey(board, &transform);
+    canonical = Symmetry::apply(transform, board);
+    return transform;
+}
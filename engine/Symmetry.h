@@ -0,0 +1,57 @@
+#ifndef SYMMETRY_H
+#define SYMMETRY_H
+
+#include "Board.h"
+
+// As 8 simetrias do quadrado (rotacoes e reflexoes) aplicadas as casas.
+//
+// O conjunto das 9 casas e invariante em todas elas, entao a mesma tabela
+// de permutacao vale para os dois modos; na inicializacao confere-se que
+// vizinhanca e linhas de vitoria de cada modo sao preservadas.
+class Symmetry {
+public:
+    enum Transform {
+        Identity,
+        Rotate90,
+        Rotate180,
+        Rotate270,
+        FlipHorizontal,
+        FlipVertical,
+        FlipDiagonal,
+        FlipAntiDiagonal,
+        TransformCount
+    };
+
+    static int apply(Transform transform, int id) { return s_tables.holes[transform][id]; }
+    static Mask apply(Transform transform, Mask mask) {
+        return static_cast<Mask>(s_tables.low[transform][mask & 0xFF] | s_tables.high[transform][mask >> 8]);
+    }
+    static Move apply(Transform transform, Move move);
+    static Board apply(Transform transform, const Board& board);
+
+    static Transform inverse(Transform transform) { return s_tables.inverse[transform]; }
+
+    // Representante canonico: a imagem com o menor par (vermelho, azul).
+    // Devolve a transformacao t tal que canonical == apply(t, board).
+    static Transform canonicalize(const Board& board, Board& canonical);
+    static uint32_t canonicalKey(const Board& board, Transform* transform = nullptr);
+
+    // Leva uma jogada achada na posicao canonica de volta para a original.
+    static Move toOriginal(Transform transform, Move move) {
+        return Symmetry::apply(Symmetry::inverse(transform), move);
+    }
+
+private:
+    struct Tables {
+        Tables();
+
+        int8_t holes[TransformCount][Board::HoleCount];
+        Mask low[TransformCount][256];
+        Mask high[TransformCount][1 << (Board::HoleCount - 8)];
+        Transform inverse[TransformCount];
+    };
+
+    static const Tables s_tables;
+};
+
+#endif // SYMMETRY_H
@@ -0,0 +1,76 @@
+#include "Tablebase.h"
+
+#include <cstring>
+
+static const char s_magic[4] = { 'P', 'C', 'T', 'B' };
+
+Tablebase::Tablebase()
+    : m_entries(nullptr) {
+}
+
+bool Tablebase::attach(const void* data, size_t size, Board::Mode mode) {
+    m_entries = nullptr;
+    if (data == nullptr || size != sizeof(Header) + PositionIndex::Size * sizeof(uint16_t))
+        return false;
+
+    Header header;
+    std::memcpy(&header, data, sizeof(header));
+    if (std::memcmp(header.magic, s_magic, sizeof(s_magic)) != 0 || header.version != Version ||
+            header.mode != mode || header.count != static_cast<uint32_t>(PositionIndex::Size))
+        return false;
+
+    m_entries = reinterpret_cast<const uint16_t*>(static_cast<const char*>(data) + sizeof(Header));
+    return true;
+}
+
+void Tablebase::detach() {
+    m_entries = nullptr;
+}
+
+Tablebase::Header Tablebase::makeHeader(Board::Mode mode) {
+    Header header;
+    std::memcpy(header.magic, s_magic, sizeof(s_magic));
+    header.mode = static_cast<uint8_t>(mode);
+    header.version = Version;
+    header.reserved = 0;
+    header.count = PositionIndex::Size;
+    return header;
+}
+
+const char* Tablebase::fileName(Board::Mode mode) {
+    return mode == Board::NineHoles ? "picaria-9.tb" : "picaria-13.tb";
+}
+
+Move Tablebase::bestMove(const Board& board) const {
+    Move moves[Board::MaxMoves];
+    int count = board.generateMoves(moves);
+
+    Move best;
+    int bestScore = 0;
+    for (int i = 0; i < count; ++i) {
+        Board child(board);
+        child.play(moves[i]);
+
+        // Score do ponto de vista de quem joga agora.
+        uint16_t value = this->entry(child);
+        int score;
+        switch (Tablebase::result(value)) {
+            case Tablebase::Loss:
+                score = 2 * MaxDistance - Tablebase::distance(value);
+                break;
+            case Tablebase::Win:
+                score = Tablebase::distance(value) - MaxDistance;
+                break;
+            default:
+                score = 0;
+                break;
+        }
+
+        if (best.isNull() || score > bestScore) {
+            best = moves[i];
+            bestScore = score;
+        }
+    }
+
+    return best;
+}
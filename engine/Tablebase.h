@@ -0,0 +1,66 @@
+#ifndef TABLEBASE_H
+#define TABLEBASE_H
+
+#include "Board.h"
+#include "PositionIndex.h"
+
+#include <cstddef>
+
+// Tabela completa de resultados de um modo, indexada por PositionIndex.
+//
+// Formato do arquivo (little-endian): um Tablebase::Header seguido de
+// PositionIndex::Size entradas de 16 bits. Cada entrada guarda o resultado
+// do ponto de vista de quem joga nos 2 bits altos e a distancia ate o fim
+// da partida (em lances) nos 14 bits baixos.
+class Tablebase {
+public:
+    enum Result {
+        Unknown,    // posicao inalcancavel
+        Win,
+        Loss,
+        Draw
+    };
+
+    struct Header {
+        char magic[4];
+        uint8_t mode;
+        uint8_t version;
+        uint16_t reserved;
+        uint32_t count;
+    };
+
+    static const uint8_t Version = 1;
+    static const int MaxDistance = 0x3FFF;
+
+    Tablebase();
+
+    // Nao copia os dados: o buffer (normalmente um arquivo mapeado)
+    // precisa viver mais que o Tablebase.
+    bool attach(const void* data, size_t size, Board::Mode mode);
+    void detach();
+    bool isValid() const { return m_entries != nullptr; }
+
+    uint16_t entry(int index) const { return m_entries[index]; }
+    uint16_t entry(const Board& board) const { return m_entries[PositionIndex::index(board)]; }
+
+    Result result(const Board& board) const { return Tablebase::result(this->entry(board)); }
+    int distance(const Board& board) const { return Tablebase::distance(this->entry(board)); }
+
+    static Result result(uint16_t entry) { return static_cast<Result>(entry >> 14); }
+    static int distance(uint16_t entry) { return entry & MaxDistance; }
+    static uint16_t makeEntry(Result result, int distance) {
+        return static_cast<uint16_t>((result << 14) | (distance & MaxDistance));
+    }
+
+    static Header makeHeader(Board::Mode mode);
+    static const char* fileName(Board::Mode mode);
+
+    // Melhor jogada segundo a tabela: ganha o mais rapido possivel,
+    // perde o mais devagar possivel.
+    Move bestMove(const Board& board) const;
+
+private:
+    const uint16_t* m_entries;
+};
+
+#endif // TABLEBASE_H
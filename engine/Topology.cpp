@@ -0,0 +1,113 @@
+#include "Topology.h"
+
+#include <cassert>
+
+#define H(id) (1u << (id))
+
+static const Mask s_nineHolesMask =
+    H(0) | H(1) | H(2) | H(5) | H(6) | H(7) | H(10) | H(11) | H(12);
+
+static const Mask s_nineHolesAdjacency[Topology::HoleCount] = {
+    H(1) | H(5) | H(6),                                         // 0
+    H(0) | H(2) | H(5) | H(6) | H(7),                           // 1
+    H(1) | H(6) | H(7),                                         // 2
+    0,                                                          // 3
+    0,                                                          // 4
+    H(0) | H(1) | H(6) | H(10) | H(11),                         // 5
+    H(0) | H(1) | H(2) | H(5) | H(7) | H(10) | H(11) | H(12),   // 6
+    H(1) | H(2) | H(6) | H(11) | H(12),                         // 7
+    0,                                                          // 8
+    0,                                                          // 9
+    H(5) | H(6) | H(11),                                        // 10
+    H(5) | H(6) | H(7) | H(10) | H(12),                         // 11
+    H(6) | H(7) | H(11)                                         // 12
+};
+
+static const Mask s_nineHolesLines[] = {
+    H(0) | H(1) | H(2),
+    H(5) | H(6) | H(7),
+    H(10) | H(11) | H(12),
+    H(0) | H(5) | H(10),
+    H(1) | H(6) | H(11),
+    H(2) | H(7) | H(12),
+    H(0) | H(6) | H(12),
+    H(2) | H(6) | H(10)
+};
+
+static const Mask s_thirteenHolesMask = 0x1FFF;
+
+static const Mask s_thirteenHolesAdjacency[Topology::HoleCount] = {
+    H(1) | H(3) | H(5),                                         // 0
+    H(0) | H(2) | H(3) | H(4) | H(6),                           // 1
+    H(1) | H(4) | H(7),                                         // 2
+    H(0) | H(1) | H(5) | H(6),                                  // 3
+    H(1) | H(2) | H(6) | H(7),                                  // 4
+    H(0) | H(3) | H(6) | H(8) | H(10),                          // 5
+    H(1) | H(3) | H(4) | H(5) | H(7) | H(8) | H(9) | H(11),     // 6
+    H(2) | H(4) | H(6) | H(9) | H(12),                          // 7
+    H(5) | H(6) | H(10) | H(11),                                // 8
+    H(6) | H(7) | H(11) | H(12),                                // 9
+    H(5) | H(8) | H(11),                                        // 10
+    H(6) | H(8) | H(9) | H(10) | H(12),                         // 11
+    H(7) | H(9) | H(11)                                         // 12
+};
+
+static const Mask s_thirteenHolesLines[] = {
+    H(0) | H(1) | H(2),
+    H(5) | H(6) | H(7),
+    H(10) | H(11) | H(12),
+    H(0) | H(5) | H(10),
+    H(1) | H(6) | H(11),
+    H(2) | H(7) | H(12),
+    H(0) | H(3) | H(6),
+    H(1) | H(3) | H(5),
+    H(5) | H(8) | H(11),
+    H(6) | H(8) | H(10),
+    H(1) | H(4) | H(7),
+    H(2) | H(4) | H(6),
+    H(6) | H(9) | H(12),
+    H(7) | H(9) | H(11),
+    H(3) | H(6) | H(9),
+    H(4) | H(6) | H(8)
+};
+
+#undef H
+
+static Topology makeTopology(Mask holes, const Mask* adjacency, const Mask* lines, int lineCount) {
+    assert(lineCount <= Topology::MaxLines);
+
+    Topology topology;
+    topology.holes = holes;
+    topology.lineCount = lineCount;
+    for (int id = 0; id < Topology::HoleCount; ++id) {
+        topology.adjacency[id] = adjacency[id];
+        topology.lineCountAt[id] = 0;
+    }
+
+    for (int line = 0; line < lineCount; ++line) {
+        topology.lines[line] = lines[line];
+
+        Mask members = lines[line];
+        while (members) {
+            int id = popLowestBit(members);
+            assert(topology.lineCountAt[id] < Topology::MaxLinesPerHole);
+            topology.linesAt[id][topology.lineCountAt[id]++] = lines[line];
+        }
+    }
+
+    return topology;
+}
+
+const Topology& Topology::nineHoles() {
+    static const Topology topology = makeTopology(s_nineHolesMask, s_nineHolesAdjacency,
+                                                  s_nineHolesLines,
+                                                  sizeof(s_nineHolesLines) / sizeof(Mask));
+    return topology;
+}
+
+const Topology& Topology::thirteenHoles() {
+    static const Topology topology = makeTopology(s_thirteenHolesMask, s_thirteenHolesAdjacency,
+                                                  s_thirteenHolesLines,
+                                                  sizeof(s_thirteenHolesLines) / sizeof(Mask));
+    return topology;
+}
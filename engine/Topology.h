@@ -0,0 +1,35 @@
+#ifndef TOPOLOGY_H
+#define TOPOLOGY_H
+
+#include "Bits.h"
+
+// Casas validas e vizinhanca de cada modo de tabuleiro.
+//
+//   0   1   2
+//     3   4
+//   5   6   7
+//     8   9
+//  10  11  12
+//
+// No modo de nove casas as casas 3, 4, 8 e 9 nao existem.
+struct Topology {
+    static const int HoleCount = 13;
+    static const int MaxLines = 16;
+    static const int MaxLinesPerHole = 8;
+
+    Mask holes;
+    Mask adjacency[HoleCount];
+
+    int lineCount;
+    Mask lines[MaxLines];
+
+    // Linhas de vitoria que passam por cada casa, para que a verificacao
+    // depois de uma jogada olhe apenas a casa que mudou.
+    int lineCountAt[HoleCount];
+    Mask linesAt[HoleCount][MaxLinesPerHole];
+
+    static const Topology& nineHoles();
+    static const Topology& thirteenHoles();
+};
+
+#endif // TOPOLOGY_H
@@ -0,0 +1,209 @@
+#include "Trace.h"
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace {
+
+struct Buffer {
+    Buffer() : count(0), inUse(true) {}
+
+    Trace::Event events[Trace::EventsPerThread];
+    // Escrito so pela thread dona; a exportacao le ate aqui.
+    std::atomic<size_t> count;
+    bool inUse;
+};
+
+struct Registry {
+    Registry() : dropped(0) {}
+
+    std::mutex mutex;
+    std::vector<std::unique_ptr<Buffer> > buffers;
+    std::vector<std::string> threadNames;      // indice = Event::thread
+    std::atomic<uint64_t> dropped;
+};
+
+Registry& registry() {
+    static Registry instance;
+    return instance;
+}
+
+// Buffer da thread atual, devolvido ao registro quando ela termina.
+struct Local {
+    Local() : buffer(nullptr), thread(0) {}
+
+    ~Local() {
+        if (buffer) {
+            std::lock_guard<std::mutex> lock(registry().mutex);
+            buffer->inUse = false;
+        }
+    }
+
+    void attach() {
+        Registry& shared = registry();
+        std::lock_guard<std::mutex> lock(shared.mutex);
+        thread = static_cast<uint32_t>(shared.threadNames.size());
+        shared.threadNames.push_back(std::string());
+
+        for (const std::unique_ptr<Buffer>& candidate : shared.buffers) {
+            if (!candidate->inUse) {
+                candidate->inUse = true;
+                buffer = candidate.get();
+                return;
+            }
+        }
+        shared.buffers.push_back(std::unique_ptr<Buffer>(new Buffer));
+        buffer = shared.buffers.back().get();
+    }
+
+    Buffer* buffer;
+    uint32_t thread;
+};
+
+thread_local Local t_local;
+
+void appendEscaped(std::string& out, const char* text) {
+    for (; *text; ++text) {
+        if (*text == '"' || *text == '\\')
+            out += '\\';
+        out += *text;
+    }
+}
+
+}
+
+Trace::Scope::Scope(const char* name) {
+    m_event.name = name;
+    m_event.argNames[0] = nullptr;
+    m_event.argNames[1] = nullptr;
+    m_event.start = Trace::now();
+}
+
+Trace::Scope::Scope(const char* name, const char* arg0, int64_t value0) {
+    m_event.name = name;
+    m_event.argNames[0] = arg0;
+    m_event.argNames[1] = nullptr;
+    m_event.args[0] = value0;
+    m_event.start = Trace::now();
+}
+
+Trace::Scope::Scope(const char* name, const char* arg0, int64_t value0, const char* arg1, int64_t value1) {
+    m_event.name = name;
+    m_event.argNames[0] = arg0;
+    m_event.argNames[1] = arg1;
+    m_event.args[0] = value0;
+    m_event.args[1] = value1;
+    m_event.start = Trace::now();
+}
+
+Trace::Scope::~Scope() {
+    m_event.duration = Trace::now() - m_event.start;
+    Trace::record(m_event);
+}
+
+uint64_t Trace::now() {
+    typedef std::chrono::steady_clock Clock;
+    static const Clock::time_point epoch = Clock::now();
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - epoch).count());
+}
+
+void Trace::setThreadName(const char* name) {
+    if (t_local.buffer == nullptr)
+        t_local.attach();
+
+    std::lock_guard<std::mutex> lock(registry().mutex);
+    registry().threadNames[t_local.thread] = name;
+}
+
+void Trace::record(const Event& event) {
+    if (t_local.buffer == nullptr)
+        t_local.attach();
+
+    Buffer& buffer = *t_local.buffer;
+    const size_t count = buffer.count.load(std::memory_order_relaxed);
+    if (count == static_cast<size_t>(EventsPerThread)) {
+        registry().dropped.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+
+    buffer.events[count] = event;
+    buffer.events[count].thread = t_local.thread;
+    buffer.count.store(count + 1, std::memory_order_release);
+}
+
+uint64_t Trace::recorded() {
+    Registry& shared = registry();
+    std::lock_guard<std::mutex> lock(shared.mutex);
+    uint64_t total = 0;
+    for (const std::unique_ptr<Buffer>& buffer : shared.buffers)
+        total += buffer->count.load(std::memory_order_acquire);
+    return total;
+}
+
+uint64_t Trace::dropped() {
+    return registry().dropped.load(std::memory_order_relaxed);
+}
+
+std::string Trace::json() {
+    Registry& shared = registry();
+    std::lock_guard<std::mutex> lock(shared.mutex);
+
+    std::string out = "{\"traceEvents\":[";
+    bool first = true;
+    char number[96];
+
+    for (size_t thread = 0; thread < shared.threadNames.size(); ++thread) {
+        if (shared.threadNames[thread].empty())
+            continue;
+        out += first ? "\n" : ",\n";
+        first = false;
+        std::snprintf(number, sizeof(number), "{\"ph\":\"M\",\"pid\":1,\"tid\":%u,\"name\":\"thread_name\",\"args\":{\"name\":\"",
+                      static_cast<unsigned>(thread));
+        out += number;
+        appendEscaped(out, shared.threadNames[thread].c_str());
+        out += "\"}}";
+    }
+
+    for (const std::unique_ptr<Buffer>& buffer : shared.buffers) {
+        const size_t count = buffer->count.load(std::memory_order_acquire);
+        for (size_t i = 0; i < count; ++i) {
+            const Event& event = buffer->events[i];
+            out += first ? "\n" : ",\n";
+            first = false;
+            out += "{\"name\":\"";
+            appendEscaped(out, event.name);
+            std::snprintf(number, sizeof(number), "\",\"ph\":\"X\",\"pid\":1,\"tid\":%u,\"ts\":%.3f,\"dur\":%.3f",
+                          static_cast<unsigned>(event.thread), event.start / 1000.0, event.duration / 1000.0);
+            out += number;
+
+            if (event.argNames[0]) {
+                out += ",\"args\":{";
+                for (int arg = 0; arg < MaxArgs && event.argNames[arg]; ++arg) {
+                    out += arg ? ",\"" : "\"";
+                    appendEscaped(out, event.argNames[arg]);
+                    std::snprintf(number, sizeof(number), "\":%lld", static_cast<long long>(event.args[arg]));
+                    out += number;
+                }
+                out += "}";
+            }
+            out += "}";
+        }
+    }
+
+    out += "\n],\"displayTimeUnit\":\"ms\"}\n";
+    return out;
+}
+
+bool Trace::save(const std::string& path) {
+    FILE* file = std::fopen(path.c_str(), "wb");
+    if (file == nullptr)
+        return false;
+
+    const std::string text = Trace::json();
+    const bool ok = std::fwrite(text.data(), 1, text.size(), file) == text.size();
+    return std::fclose(file) == 0 && ok;
+}
@@ -0,0 +1,81 @@
+#ifndef TRACE_H
+#define TRACE_H
+
+#include <cstdint>
+#include <string>
+
+// Linha do tempo de eventos com duracao (inicio, fim, thread e ate dois
+// argumentos inteiros), exportada no formato JSON de eventos do Chrome
+// (chrome://tracing, Perfetto).
+//
+// Cada thread grava num buffer proprio, sem travas; so a primeira gravacao
+// de uma thread toma o mutex para pegar um buffer. Buffers de threads que
+// terminaram sao reaproveitados por threads novas (a busca cria as suas a
+// cada jogada) e os eventos antigos continuam nele. Quando um buffer enche,
+// os eventos seguintes sao descartados e contados em dropped().
+//
+// Os macros PICARIA_TRACE_* so geram codigo com PICARIA_TRACING definido
+// (qmake CONFIG+=tracing); sem ele nao custam nada.
+class Trace {
+public:
+    static const int EventsPerThread = 1 << 16;
+    static const int MaxArgs = 2;
+
+    struct Event {
+        const char* name;
+        const char* argNames[MaxArgs];     // nulo = sem argumento
+        int64_t args[MaxArgs];
+        uint64_t start;                     // nanossegundos desde o inicio do programa
+        uint64_t duration;
+        uint32_t thread;
+    };
+
+    // Grava um evento do construtor ao destrutor. Nomes precisam ser
+    // literais (ou viver ate a exportacao): so o ponteiro e guardado.
+    class Scope {
+    public:
+        explicit Scope(const char* name);
+        Scope(const char* name, const char* arg0, int64_t value0);
+        Scope(const char* name, const char* arg0, int64_t value0, const char* arg1, int64_t value1);
+        ~Scope();
+
+    private:
+        Scope(const Scope&);
+        Scope& operator=(const Scope&);
+
+        Event m_event;
+    };
+
+    static uint64_t now();
+
+    // Nome da thread atual na linha do tempo.
+    static void setThreadName(const char* name);
+
+    static void record(const Event& event);
+    static uint64_t recorded();
+    static uint64_t dropped();
+
+    // Pode ser chamado com outras threads gravando: exporta o que ja foi
+    // gravado ate aqui.
+    static std::string json();
+    static bool save(const std::string& path);
+};
+
+#ifdef PICARIA_TRACING
+#define PICARIA_TRACE_CONCAT2(a, b) a##b
+#define PICARIA_TRACE_CONCAT(a, b) PICARIA_TRACE_CONCAT2(a, b)
+#define PICARIA_TRACE_SCOPE(name) \
+    Trace::Scope PICARIA_TRACE_CONCAT(traceScope, __LINE__)(name)
+#define PICARIA_TRACE_SCOPE1(name, arg0, value0) \
+    Trace::Scope PICARIA_TRACE_CONCAT(traceScope, __LINE__)(name, arg0, value0)
+#define PICARIA_TRACE_SCOPE2(name, arg0, value0, arg1, value1) \
+    Trace::Scope PICARIA_TRACE_CONCAT(traceScope, __LINE__)(name, arg0, value0, arg1, value1)
+#define PICARIA_TRACE_THREAD(name) Trace::setThreadName(name)
+#else
+#define PICARIA_TRACE_SCOPE(name) do {} while (0)
+#define PICARIA_TRACE_SCOPE1(name, arg0, value0) do {} while (0)
+#define PICARIA_TRACE_SCOPE2(name, arg0, value0, arg1, value1) do {} while (0)
+#define PICARIA_TRACE_THREAD(name) do {} while (0)
+#endif
+
+#endif // TRACE_H
@@ -0,0 +1,148 @@
+#include "TrainingData.h"
+
+#include <algorithm>
+#include <cstring>
+
+TrainingRecord TrainingRecord::make(const Board& board, int label) {
+    TrainingRecord record;
+    record.red = board.pieces(Board::RedPlayer);
+    record.blue = board.pieces(Board::BluePlayer);
+    record.flags = static_cast<uint8_t>((board.mode() == Board::ThirteenHoles ? ThirteenHolesFlag : 0) |
+                                        (board.phase() == Board::MovePhase ? MovePhaseFlag : 0) |
+                                        (board.player() == Board::BluePlayer ? BlueToMoveFlag : 0));
+    record.reserved = 0;
+    record.label = static_cast<int16_t>(label);
+    return record;
+}
+
+TrainingRecord::Header TrainingRecord::makeHeader(Label label) {
+    Header header;
+    std::memcpy(header.magic, "PCTD", 4);
+    header.version = Version;
+    header.label = static_cast<uint8_t>(label);
+    header.recordSize = sizeof(TrainingRecord);
+    return header;
+}
+
+TrainingWriter::TrainingWriter(size_t bufferRecords)
+    : m_front(0),
+      m_fill(0),
+      m_pending(0),
+      m_closing(false),
+      m_failed(false),
+      m_written(0),
+      m_stalls(0),
+      m_file(nullptr) {
+    m_buffers[0].resize(std::max<size_t>(bufferRecords, 1));
+    m_buffers[1].resize(m_buffers[0].size());
+}
+
+TrainingWriter::~TrainingWriter() {
+    this->close();
+}
+
+bool TrainingWriter::open(const std::string& path, TrainingRecord::Label label) {
+    this->close();
+
+    m_file = std::fopen(path.c_str(), "wb");
+    if (m_file == nullptr)
+        return false;
+
+    // A thread de escrita usa os proprios buffers; o do stdio so atrapalha.
+    std::setvbuf(m_file, nullptr, _IONBF, 0);
+
+    const TrainingRecord::Header header = TrainingRecord::makeHeader(label);
+    m_failed = std::fwrite(&header, sizeof(header), 1, m_file) != 1;
+    m_front = 0;
+    m_fill = 0;
+    m_pending = 0;
+    m_closing = false;
+    m_written = 0;
+    m_stalls = 0;
+    m_thread = std::thread(&TrainingWriter::run, this);
+    return true;
+}
+
+void TrainingWriter::append(const TrainingRecord* records, size_t count) {
+    std::unique_lock<std::mutex> lock(m_mutex);
+    const size_t capacity = m_buffers[m_front].size();
+
+    while (count > 0) {
+        const size_t n = std::min(count, capacity - m_fill);
+        std::memcpy(&m_buffers[m_front][m_fill], records, n * sizeof(TrainingRecord));
+        m_fill += n;
+        records += n;
+        count -= n;
+
+        if (m_fill == capacity)
+            this->submit(lock);
+    }
+}
+
+// Passa o buffer da frente para a thread de escrita; espera so se o
+// anterior ainda nao foi gravado.
+void TrainingWriter::submit(std::unique_lock<std::mutex>& lock) {
+    if (m_pending > 0) {
+        ++m_stalls;
+        while (m_pending > 0)
+            m_pendingDone.wait(lock);
+        // Outro produtor pode ter trocado os buffers enquanto este esperava.
+        if (m_fill == 0)
+            return;
+    }
+
+    m_pending = m_fill;
+    m_front = 1 - m_front;
+    m_fill = 0;
+    m_pendingReady.notify_one();
+}
+
+void TrainingWriter::run() {
+    std::unique_lock<std::mutex> lock(m_mutex);
+    for (;;) {
+        while (m_pending == 0 && !m_closing)
+            m_pendingReady.wait(lock);
+        if (m_pending == 0)
+            break;
+
+        // O buffer de tras so e tocado aqui ate m_pending voltar a zero.
+        const TrainingRecord* records = m_buffers[1 - m_front].data();
+        const size_t count = m_pending;
+        lock.unlock();
+        const bool ok = std::fwrite(records, sizeof(TrainingRecord), count, m_file) == count;
+        lock.lock();
+
+        m_failed = m_failed || !ok;
+        m_written += count;
+        m_pending = 0;
+        m_pendingDone.notify_all();
+    }
+}
+
+bool TrainingWriter::close() {
+    if (m_file == nullptr)
+        return !m_failed;
+
+    {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        if (m_fill > 0)
+            this->submit(lock);
+        m_closing = true;
+        m_pendingReady.notify_one();
+    }
+    m_thread.join();
+
+    m_failed = std::fclose(m_file) != 0 || m_failed;
+    m_file = nullptr;
+    return !m_failed;
+}
+
+uint64_t TrainingWriter::written() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_written;
+}
+
+uint64_t TrainingWriter::stalls() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_stalls;
+}
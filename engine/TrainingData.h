@@ -0,0 +1,106 @@
+#ifndef TRAININGDATA_H
+#define TRAININGDATA_H
+
+#include "Board.h"
+
+#include <condition_variable>
+#include <cstdint>
+#include <cstdio>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+// Registro de tamanho fixo para ajustar funcoes de avaliacao.
+//
+// Formato do arquivo (little-endian): um TrainingRecord::Header seguido de
+// registros de 8 bytes ate o fim do arquivo, entao o numero de registros
+// vem do tamanho. O rotulo e sempre do ponto de vista de quem joga, na
+// escala da busca: +-(Search::WinScore - lances ate o fim) para posicoes
+// decididas e a avaliacao nas demais.
+struct TrainingRecord {
+    enum Label {
+        TablebaseLabel,     // valor exato das tabelas de finais
+        SearchLabel,        // pontuacao de uma busca de profundidade fixa
+        ResultLabel         // resultado da partida de onde a posicao veio
+    };
+
+    // Bits de flags.
+    enum Flag {
+        ThirteenHolesFlag = 1,
+        MovePhaseFlag = 2,
+        BlueToMoveFlag = 4
+    };
+
+    struct Header {
+        char magic[4];
+        uint8_t version;
+        uint8_t label;
+        uint16_t recordSize;
+    };
+
+    static const uint8_t Version = 1;
+
+    uint16_t red;
+    uint16_t blue;
+    uint8_t flags;
+    uint8_t reserved;
+    int16_t label;
+
+    static TrainingRecord make(const Board& board, int label);
+    static Header makeHeader(Label label);
+
+    Board::Mode mode() const { return flags & ThirteenHolesFlag ? Board::ThirteenHoles : Board::NineHoles; }
+    Board::Phase phase() const { return flags & MovePhaseFlag ? Board::MovePhase : Board::DropPhase; }
+    Board::Player player() const { return flags & BlueToMoveFlag ? Board::BluePlayer : Board::RedPlayer; }
+};
+
+// Grava registros num arquivo sem que quem os produz espere pelo disco:
+// append() copia para o buffer da frente e, quando ele enche, troca com o
+// de tras, que uma thread propria grava enquanto o da frente volta a
+// encher. So se espera quando o disco e mais lento que os produtores e os
+// dois buffers estao cheios; stalls() conta essas esperas.
+//
+// append() pode ser chamado de varias threads; para reduzir a disputa pelo
+// mutex, cada uma deve acumular alguns milhares de registros por chamada.
+class TrainingWriter {
+public:
+    static const size_t DefaultBufferRecords = 1 << 17;
+
+    explicit TrainingWriter(size_t bufferRecords = DefaultBufferRecords);
+    ~TrainingWriter();
+
+    bool open(const std::string& path, TrainingRecord::Label label);
+    void append(const TrainingRecord* records, size_t count);
+
+    // Grava o que falta e fecha; false se alguma escrita falhou.
+    bool close();
+
+    uint64_t written() const;
+    uint64_t stalls() const;
+
+private:
+    TrainingWriter(const TrainingWriter&);
+    TrainingWriter& operator=(const TrainingWriter&);
+
+    void run();
+    void submit(std::unique_lock<std::mutex>& lock);
+
+    mutable std::mutex m_mutex;
+    std::condition_variable m_pendingReady;     // para a thread de escrita
+    std::condition_variable m_pendingDone;      // para os produtores
+
+    std::vector<TrainingRecord> m_buffers[2];
+    int m_front;
+    size_t m_fill;              // registros no buffer da frente
+    size_t m_pending;           // registros no buffer de tras ainda nao gravados
+    bool m_closing;
+    bool m_failed;
+    uint64_t m_written;
+    uint64_t m_stalls;
+
+    FILE* m_file;
+    std::thread m_thread;
+};
+
+#endif // TRAININGDATA_H
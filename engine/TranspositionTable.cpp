@@ -0,0 +1,62 @@
+#include "TranspositionTable.h"
+
+// Layout de data: score (16) | depth (8) | bound (8) | move (8).
+uint64_t TranspositionTable::pack(int score, int depth, Bound bound, Move move) {
+    return static_cast<uint64_t>(static_cast<uint16_t>(score)) |
+           static_cast<uint64_t>(static_cast<uint8_t>(depth)) << 16 |
+           static_cast<uint64_t>(bound) << 24 |
+           static_cast<uint64_t>(move.bits()) << 32;
+}
+
+TranspositionTable::TranspositionTable(size_t megabytes)
+    : m_mask(0) {
+    this->resize(megabytes);
+}
+
+void TranspositionTable::resize(size_t megabytes) {
+    size_t count = 1;
+    while (count * 2 * sizeof(Slot) <= megabytes * 1024 * 1024)
+        count *= 2;
+
+    m_slots.reset(new Slot[count]);
+    m_mask = count - 1;
+    this->clear();
+}
+
+void TranspositionTable::clear() {
+    for (size_t i = 0; i <= m_mask; ++i) {
+        m_slots[i].check.store(0, std::memory_order_relaxed);
+        m_slots[i].data.store(0, std::memory_order_relaxed);
+    }
+}
+
+bool TranspositionTable::probe(uint64_t key, Entry& entry) const {
+    const Slot& slot = m_slots[key & m_mask];
+    uint64_t data = slot.data.load(std::memory_order_relaxed);
+    uint64_t check = slot.check.load(std::memory_order_relaxed);
+    if ((check ^ data) != key)
+        return false;
+
+    entry.bound = static_cast<Bound>((data >> 24) & 0xFF);
+    if (entry.bound == NoBound)
+        return false;
+
+    entry.score = static_cast<int16_t>(data & 0xFFFF);
+    entry.depth = static_cast<int8_t>((data >> 16) & 0xFF);
+    entry.move = Move::fromBits(static_cast<uint8_t>(data >> 32));
+    return true;
+}
+
+void TranspositionTable::store(uint64_t key, int score, int depth, Bound bound, Move move) {
+    Slot& slot = m_slots[key & m_mask];
+
+    // Uma busca mais rasa so substitui a mesma posicao com valor exato.
+    uint64_t old = slot.data.load(std::memory_order_relaxed);
+    if ((slot.check.load(std::memory_order_relaxed) ^ old) == key &&
+            static_cast<int8_t>((old >> 16) & 0xFF) > depth && bound != ExactBound)
+        return;
+
+    uint64_t data = TranspositionTable::pack(score, depth, bound, move);
+    slot.check.store(key ^ data, std::memory_order_relaxed);
+    slot.data.store(data, std::memory_order_relaxed);
+}
@@ -0,0 +1,50 @@
+#ifndef TRANSPOSITIONTABLE_H
+#define TRANSPOSITIONTABLE_H
+
+#include "Move.h"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+// Tabela compartilhada entre as threads da busca, sem travas. Cada entrada
+// guarda os dados em 64 bits e, ao lado, a chave com xor dos dados: uma
+// escrita concorrente rasgada nao passa na verificacao e vira um miss.
+class TranspositionTable {
+public:
+    enum Bound {
+        NoBound,
+        UpperBound,
+        LowerBound,
+        ExactBound
+    };
+
+    struct Entry {
+        int score;
+        int depth;
+        Bound bound;
+        Move move;
+    };
+
+    explicit TranspositionTable(size_t megabytes = 16);
+
+    void resize(size_t megabytes);
+    void clear();
+
+    bool probe(uint64_t key, Entry& entry) const;
+    void store(uint64_t key, int score, int depth, Bound bound, Move move);
+
+private:
+    struct Slot {
+        std::atomic<uint64_t> check;    // key ^ data
+        std::atomic<uint64_t> data;
+    };
+
+    std::unique_ptr<Slot[]> m_slots;
+    size_t m_mask;
+
+    static uint64_t pack(int score, int depth, Bound bound, Move move);
+};
+
+#endif // TRANSPOSITIONTABLE_H
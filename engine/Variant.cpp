@@ -0,0 +1,58 @@
+#include "Variant.h"
+#include "VariantBoard.h"
+
+namespace {
+
+template <typename MaskT>
+class CompiledVariant : public Variant {
+public:
+    explicit CompiledVariant(const BoardDescription& description)
+        : Variant(description),
+          m_topology(description) {
+    }
+
+    int maskBits() const override { return static_cast<int>(8 * sizeof(MaskT)); }
+    int maxMoves() const override { return m_topology.maxMoves; }
+
+    uint64_t perft(int depth) const override {
+        if (depth <= 0)
+            return 1;
+
+        // Uma area de jogadas por nivel, alocada uma vez por chamada.
+        std::vector<VariantMove> moves(static_cast<size_t>(m_topology.maxMoves) * depth);
+        VariantBoard<MaskT> board(m_topology);
+        return this->perft(board, depth, moves.data());
+    }
+
+private:
+    VariantTopology<MaskT> m_topology;
+
+    uint64_t perft(VariantBoard<MaskT>& board, int depth, VariantMove* moves) const {
+        const int count = board.generateMoves(moves);
+        if (depth == 1)
+            return count;
+
+        uint64_t nodes = 0;
+        const int player = board.player();
+        for (int i = 0; i < count; ++i) {
+            board.play(moves[i]);
+            if (!board.isWinningHole(player, moves[i].to))
+                nodes += this->perft(board, depth - 1, moves + m_topology.maxMoves);
+            board.unplay(moves[i]);
+        }
+        return nodes;
+    }
+};
+
+}
+
+std::unique_ptr<Variant> Variant::compile(const BoardDescription& description, std::string* error) {
+    if (!description.validate(error))
+        return std::unique_ptr<Variant>();
+
+    if (description.holeCount <= 16)
+        return std::unique_ptr<Variant>(new CompiledVariant<uint16_t>(description));
+    if (description.holeCount <= 32)
+        return std::unique_ptr<Variant>(new CompiledVariant<uint32_t>(description));
+    return std::unique_ptr<Variant>(new CompiledVariant<uint64_t>(description));
+}
@@ -0,0 +1,36 @@
+#ifndef VARIANT_H
+#define VARIANT_H
+
+#include "BoardDescription.h"
+
+#include <cstdint>
+#include <memory>
+#include <string>
+
+// Tabuleiro descrito em texto e compilado num motor com a menor mascara
+// que cabe nele (16, 32 ou 64 bits). A escolha da largura acontece uma vez,
+// em compile(); os lacos internos sao instanciados para cada largura.
+class Variant {
+public:
+    virtual ~Variant() {}
+
+    const BoardDescription& description() const { return m_description; }
+
+    virtual int maskBits() const = 0;
+    virtual int maxMoves() const = 0;
+
+    // Mesma contagem de tools/perft: uma jogada que fecha uma linha e
+    // folha na profundidade N e encerra o ramo antes dela.
+    virtual uint64_t perft(int depth) const = 0;
+
+    // Nulo se a descricao for invalida.
+    static std::unique_ptr<Variant> compile(const BoardDescription& description, std::string* error = nullptr);
+
+protected:
+    explicit Variant(const BoardDescription& description) : m_description(description) {}
+
+private:
+    BoardDescription m_description;
+};
+
+#endif // VARIANT_H
@@ -0,0 +1,186 @@
+#ifndef VARIANTBOARD_H
+#define VARIANTBOARD_H
+
+#include "Bits.h"
+#include "BoardDescription.h"
+
+#include <cstdint>
+#include <vector>
+
+// Operacoes de bits para cada largura de mascara.
+template <typename MaskT> struct MaskTraits;
+
+template <> struct MaskTraits<uint16_t> {
+    static int count(uint16_t mask) { return bitCount(mask); }
+    static int lowest(uint16_t mask) { return lowestBit(mask); }
+};
+
+template <> struct MaskTraits<uint32_t> {
+    static int count(uint32_t mask) { return bitCount(mask); }
+    static int lowest(uint32_t mask) { return lowestBit(mask); }
+};
+
+template <> struct MaskTraits<uint64_t> {
+    static int count(uint64_t mask) { return bitCount64(mask); }
+    static int lowest(uint64_t mask) { return lowestBit64(mask); }
+};
+
+template <typename MaskT>
+inline MaskT variantBit(int id) {
+    return static_cast<MaskT>(MaskT(1) << id);
+}
+
+template <typename MaskT>
+inline int popLowestVariantBit(MaskT& mask) {
+    int id = MaskTraits<MaskT>::lowest(mask);
+    mask = static_cast<MaskT>(mask & (mask - 1));
+    return id;
+}
+
+// Jogada de uma variante: as casas podem passar de 15, entao a origem e
+// o destino ocupam um byte cada.
+struct VariantMove {
+    static const uint8_t NoHole = 0xFF;
+
+    uint8_t from;
+    uint8_t to;
+
+    bool isDrop() const { return from == NoHole; }
+};
+
+// Descricao ja validada e compilada em mascaras da largura MaskT.
+template <typename MaskT>
+struct VariantTopology {
+    int holeCount;
+    int piecesPerPlayer;
+    int maxMoves;
+    MaskT holes;
+    std::vector<MaskT> adjacency;
+
+    // Linhas de vitoria que passam por cada casa:
+    // linesAt[lineOffsets[id] .. lineOffsets[id + 1]).
+    std::vector<int> lineOffsets;
+    std::vector<MaskT> linesAt;
+
+    explicit VariantTopology(const BoardDescription& description);
+};
+
+template <typename MaskT>
+VariantTopology<MaskT>::VariantTopology(const BoardDescription& description)
+    : holeCount(description.holeCount),
+      piecesPerPlayer(description.piecesPerPlayer),
+      maxMoves(0),
+      holes(0),
+      adjacency(description.holeCount, 0),
+      lineOffsets(description.holeCount + 1, 0) {
+    for (int id = 0; id < holeCount; ++id)
+        holes |= variantBit<MaskT>(id);
+
+    for (const std::pair<int, int>& edge : description.edges) {
+        adjacency[edge.first] |= variantBit<MaskT>(edge.second);
+        adjacency[edge.second] |= variantBit<MaskT>(edge.first);
+    }
+
+    int maxDegree = 0;
+    for (int id = 0; id < holeCount; ++id) {
+        const int degree = MaskTraits<MaskT>::count(adjacency[id]);
+        maxDegree = degree > maxDegree ? degree : maxDegree;
+    }
+    maxMoves = holeCount > piecesPerPlayer * maxDegree ? holeCount : piecesPerPlayer * maxDegree;
+
+    std::vector<MaskT> lines;
+    for (const std::vector<int>& line : description.lines) {
+        MaskT mask = 0;
+        for (int id : line)
+            mask |= variantBit<MaskT>(id);
+        lines.push_back(mask);
+    }
+
+    for (int id = 0; id < holeCount; ++id) {
+        lineOffsets[id] = static_cast<int>(linesAt.size());
+        for (MaskT line : lines) {
+            if (line & variantBit<MaskT>(id))
+                linesAt.push_back(line);
+        }
+    }
+    lineOffsets[holeCount] = static_cast<int>(linesAt.size());
+}
+
+// Mesmas regras de Board, sobre uma topologia qualquer.
+template <typename MaskT>
+class VariantBoard {
+public:
+    explicit VariantBoard(const VariantTopology<MaskT>& topology)
+        : m_topology(&topology),
+          m_player(0),
+          m_dropCount(0) {
+        m_pieces[0] = 0;
+        m_pieces[1] = 0;
+    }
+
+    int player() const { return m_player; }
+    bool isDropPhase() const { return m_dropCount < 2 * m_topology->piecesPerPlayer; }
+    MaskT pieces(int player) const { return m_pieces[player]; }
+    MaskT empty() const { return static_cast<MaskT>(m_topology->holes & ~(m_pieces[0] | m_pieces[1])); }
+
+    // 'moves' precisa de espaco para topology.maxMoves jogadas.
+    int generateMoves(VariantMove* moves) const {
+        int count = 0;
+        const MaskT empty = this->empty();
+        if (this->isDropPhase()) {
+            MaskT targets = empty;
+            while (targets) {
+                moves[count].from = VariantMove::NoHole;
+                moves[count++].to = static_cast<uint8_t>(popLowestVariantBit(targets));
+            }
+        } else {
+            MaskT pieces = m_pieces[m_player];
+            while (pieces) {
+                const int from = popLowestVariantBit(pieces);
+                MaskT targets = static_cast<MaskT>(m_topology->adjacency[from] & empty);
+                while (targets) {
+                    moves[count].from = static_cast<uint8_t>(from);
+                    moves[count++].to = static_cast<uint8_t>(popLowestVariantBit(targets));
+                }
+            }
+        }
+        return count;
+    }
+
+    void play(VariantMove move) {
+        if (move.isDrop())
+            ++m_dropCount;
+        else
+            m_pieces[m_player] &= static_cast<MaskT>(~variantBit<MaskT>(move.from));
+        m_pieces[m_player] |= variantBit<MaskT>(move.to);
+        m_player ^= 1;
+    }
+
+    void unplay(VariantMove move) {
+        m_player ^= 1;
+        m_pieces[m_player] &= static_cast<MaskT>(~variantBit<MaskT>(move.to));
+        if (move.isDrop())
+            --m_dropCount;
+        else
+            m_pieces[m_player] |= variantBit<MaskT>(move.from);
+    }
+
+    bool isWinningHole(int player, int id) const {
+        const MaskT pieces = m_pieces[player];
+        const MaskT* line = m_topology->linesAt.data() + m_topology->lineOffsets[id];
+        const MaskT* end = m_topology->linesAt.data() + m_topology->lineOffsets[id + 1];
+        for (; line != end; ++line) {
+            if ((pieces & *line) == *line)
+                return true;
+        }
+        return false;
+    }
+
+private:
+    const VariantTopology<MaskT>* m_topology;
+    MaskT m_pieces[2];
+    int m_player;
+    int m_dropCount;
+};
+
+#endif // VARIANTBOARD_H
@@ -0,0 +1,35 @@
+#include "Zobrist.h"
+
+const Zobrist::Keys Zobrist::s_keys;
+
+static uint64_t splitMix64(uint64_t& state) {
+    uint64_t z = (state += 0x9E3779B97F4A7C15ull);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+    return z ^ (z >> 31);
+}
+
+Zobrist::Keys::Keys() {
+    uint64_t state = 0x5069636172696121ull;
+    for (int player = 0; player < 2; ++player) {
+        for (int id = 0; id < Board::HoleCount; ++id)
+            pieces[player][id] = splitMix64(state);
+    }
+    side = splitMix64(state);
+    modes[Board::NineHoles] = splitMix64(state);
+    modes[Board::ThirteenHoles] = splitMix64(state);
+}
+
+uint64_t Zobrist::hash(const Board& board) {
+    uint64_t key = s_keys.modes[board.mode()];
+    if (board.player() == Board::BluePlayer)
+        key ^= s_keys.side;
+
+    for (int player = 0; player < 2; ++player) {
+        Mask pieces = board.pieces(static_cast<Board::Player>(player));
+        while (pieces)
+            key ^= s_keys.pieces[player][popLowestBit(pieces)];
+    }
+
+    return key;
+}
@@ -0,0 +1,35 @@
+#ifndef ZOBRIST_H
+#define ZOBRIST_H
+
+#include "Board.h"
+
+// Chaves de Zobrist para posicoes dos dois modos.
+class Zobrist {
+public:
+    static uint64_t hash(const Board& board);
+
+    static uint64_t piece(Board::Player player, int id) { return s_keys.pieces[player][id]; }
+    static uint64_t side() { return s_keys.side; }
+    static uint64_t mode(Board::Mode mode) { return s_keys.modes[mode]; }
+
+    // Diferenca de hash causada por 'move' jogado por 'player'; inclui a troca de vez.
+    static uint64_t move(Board::Player player, Move move) {
+        uint64_t key = s_keys.side ^ s_keys.pieces[player][move.to()];
+        if (!move.isDrop())
+            key ^= s_keys.pieces[player][move.from()];
+        return key;
+    }
+
+private:
+    struct Keys {
+        Keys();
+
+        uint64_t pieces[2][Board::HoleCount];
+        uint64_t side;
+        uint64_t modes[2];
+    };
+
+    static const Keys s_keys;
+};
+
+#endif // ZOBRIST_H
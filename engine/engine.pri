@@ -0,0 +1,19 @@
+# Inclua este arquivo nos projetos que usam o motor do jogo.
+ENGINE_BUILD_DIR = $$shadowed($$PWD)
+
+INCLUDEPATH += $$PWD
+DEPENDPATH += $$PWD
+
+# A busca usa std::thread.
+CONFIG += thread
+
+# Os mesmos macros de rastreamento do motor (qmake CONFIG+=tracing).
+tracing: DEFINES += PICARIA_TRACING
+
+win32:CONFIG(release, debug|release): ENGINE_BUILD_DIR = $$ENGINE_BUILD_DIR/release
+else:win32:CONFIG(debug, debug|release): ENGINE_BUILD_DIR = $$ENGINE_BUILD_DIR/debug
+
+LIBS += -L$$ENGINE_BUILD_DIR -lpicariaengine
+
+win32-msvc*: PRE_TARGETDEPS += $$ENGINE_BUILD_DIR/picariaengine.lib
+else: PRE_TARGETDEPS += $$ENGINE_BUILD_DIR/libpicariaengine.a
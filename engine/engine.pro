@@ -0,0 +1,53 @@
+TEMPLATE = lib
+TARGET = picariaengine
+
+CONFIG += staticlib c++11
+CONFIG -= qt
+
+# qmake CONFIG+=tracing liga os PICARIA_TRACE_* (ver Trace.h).
+tracing: DEFINES += PICARIA_TRACING
+
+SOURCES += \
+    Analyser.cpp \
+    BatchEval.cpp \
+    Board.cpp \
+    BoardDescription.cpp \
+    DrawRules.cpp \
+    Evaluation.cpp \
+    Mcts.cpp \
+    OpeningBook.cpp \
+    PositionIndex.cpp \
+    Search.cpp \
+    Symmetry.cpp \
+    Tablebase.cpp \
+    Topology.cpp \
+    Trace.cpp \
+    TrainingData.cpp \
+    TranspositionTable.cpp \
+    Variant.cpp \
+    Zobrist.cpp
+
+HEADERS += \
+    Analyser.h \
+    BatchEval.h \
+    Bits.h \
+    Board.h \
+    BoardDescription.h \
+    DrawRules.h \
+    Evaluation.h \
+    Mcts.h \
+    Move.h \
+    MoveHistory.h \
+    OpeningBook.h \
+    PositionIndex.h \
+    Search.h \
+    SpscRing.h \
+    Symmetry.h \
+    Tablebase.h \
+    Topology.h \
+    Trace.h \
+    TrainingData.h \
+    TranspositionTable.h \
+    Variant.h \
+    VariantBoard.h \
+    Zobrist.h
@@ -0,0 +1,65 @@
+#ifndef PROTOCOL_H
+#define PROTOCOL_H
+
+#include <cstdint>
+
+// Protocolo entre o servidor de partidas e seus clientes.
+//
+// Cada mensagem, nos dois sentidos, e um quadro fixo de 8 bytes
+// (little-endian): operacao, argumento, etiqueta escolhida pelo cliente
+// (devolvida sem mudancas na resposta) e numero da sessao. Varias sessoes
+// compartilham a mesma conexao, e o cliente pode mandar varios quadros
+// sem esperar as respostas.
+namespace Protocol {
+
+const char* const DefaultServerName = "picaria";
+
+enum Operation {
+    NewGame,    // arg = Board::Mode; a resposta traz a sessao criada
+    Play,       // arg = Move::bits() da jogada de quem tem a vez
+    Close,      // encerra a sessao
+    Reply = 0x80
+};
+
+enum Status {
+    Accepted,       // jogada feita, a partida continua
+    Won,            // quem jogou formou uma linha
+    Blocked,        // o adversario ficou sem jogadas e perdeu
+    Illegal,        // jogada invalida; nada mudou
+    Finished,       // a partida da sessao ja acabou
+    UnknownSession,
+    BadRequest
+};
+
+struct Frame {
+    uint8_t operation;
+    uint8_t argument;
+    uint16_t tag;
+    uint32_t session;
+};
+
+const int FrameSize = 8;
+
+inline void encode(const Frame& frame, char* out) {
+    out[0] = static_cast<char>(frame.operation);
+    out[1] = static_cast<char>(frame.argument);
+    out[2] = static_cast<char>(frame.tag & 0xFF);
+    out[3] = static_cast<char>(frame.tag >> 8);
+    for (int i = 0; i < 4; ++i)
+        out[4 + i] = static_cast<char>((frame.session >> (8 * i)) & 0xFF);
+}
+
+inline Frame decode(const char* in) {
+    const unsigned char* bytes = reinterpret_cast<const unsigned char*>(in);
+    Frame frame;
+    frame.operation = bytes[0];
+    frame.argument = bytes[1];
+    frame.tag = static_cast<uint16_t>(bytes[2] | bytes[3] << 8);
+    frame.session = static_cast<uint32_t>(bytes[4]) | static_cast<uint32_t>(bytes[5]) << 8 |
+                    static_cast<uint32_t>(bytes[6]) << 16 | static_cast<uint32_t>(bytes[7]) << 24;
+    return frame;
+}
+
+}
+
+#endif // PROTOCOL_H
@@ -0,0 +1,83 @@
+#include "Connection.h"
+
+#include <QLocalSocket>
+
+Connection::Connection(quintptr descriptor, std::atomic<quint64>* moves, QObject *parent)
+        : QObject(parent),
+          m_socket(new QLocalSocket(this)),
+          m_moves(moves) {
+    // Com capacidade reservada, resize(0) mantem o buffer entre os lotes.
+    m_output.reserve(4096);
+    m_socket->setSocketDescriptor(descriptor);
+
+    QObject::connect(m_socket, SIGNAL(readyRead()), this, SLOT(process()));
+    QObject::connect(m_socket, SIGNAL(disconnected()), this, SLOT(finish()));
+}
+
+Connection::~Connection() {
+}
+
+bool Connection::isValid() const {
+    return m_socket->state() == QLocalSocket::ConnectedState;
+}
+
+void Connection::process() {
+    m_input.append(m_socket->readAll());
+
+    const int frames = m_input.size() / Protocol::FrameSize;
+    if (frames == 0)
+        return;
+
+    const int offset = m_output.size();
+    m_output.resize(offset + frames * Protocol::FrameSize);
+
+    const char* in = m_input.constData();
+    char* out = m_output.data() + offset;
+    for (int i = 0; i < frames; ++i) {
+        Protocol::Frame reply = this->handle(Protocol::decode(in));
+        Protocol::encode(reply, out);
+        in += Protocol::FrameSize;
+        out += Protocol::FrameSize;
+    }
+    m_input.remove(0, frames * Protocol::FrameSize);
+
+    // Uma escrita por lote de quadros recebidos.
+    m_socket->write(m_output);
+    m_output.resize(0);
+}
+
+Protocol::Frame Connection::handle(const Protocol::Frame& request) {
+    Protocol::Frame reply;
+    reply.operation = static_cast<uint8_t>(request.operation | Protocol::Reply);
+    reply.argument = Protocol::Accepted;
+    reply.tag = request.tag;
+    reply.session = request.session;
+
+    switch (request.operation) {
+        case Protocol::NewGame:
+            if (request.argument > Board::ThirteenHoles)
+                reply.argument = Protocol::BadRequest;
+            else
+                reply.session = m_sessions.create(static_cast<Board::Mode>(request.argument));
+            break;
+        case Protocol::Play:
+            reply.argument = static_cast<uint8_t>(m_sessions.play(request.session, Move::fromBits(request.argument)));
+            if (reply.argument != Protocol::Illegal && reply.argument != Protocol::UnknownSession &&
+                    reply.argument != Protocol::Finished)
+                m_moves->fetch_add(1, std::memory_order_relaxed);
+            break;
+        case Protocol::Close:
+            if (!m_sessions.close(request.session))
+                reply.argument = Protocol::UnknownSession;
+            break;
+        default:
+            reply.argument = Protocol::BadRequest;
+            break;
+    }
+
+    return reply;
+}
+
+void Connection::finish() {
+    emit closed(this);
+}
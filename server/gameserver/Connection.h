@@ -0,0 +1,43 @@
+#ifndef CONNECTION_H
+#define CONNECTION_H
+
+#include <QObject>
+#include <QByteArray>
+
+#include <atomic>
+
+#include "SessionTable.h"
+
+class QLocalSocket;
+
+// Uma conexao de cliente e as sessoes abertas por ela. Vive na thread
+// do Shard que a aceitou; todos os quadros completos de uma leitura sao
+// tratados de uma vez e as respostas saem numa unica escrita.
+class Connection : public QObject {
+    Q_OBJECT
+
+public:
+    Connection(quintptr descriptor, std::atomic<quint64>* moves, QObject *parent = nullptr);
+    virtual ~Connection();
+
+    bool isValid() const;
+    int sessions() const { return m_sessions.active(); }
+
+signals:
+    void closed(Connection* connection);
+
+private slots:
+    void process();
+    void finish();
+
+private:
+    QLocalSocket* m_socket;
+    SessionTable m_sessions;
+    QByteArray m_input;
+    QByteArray m_output;
+    std::atomic<quint64>* m_moves;
+
+    Protocol::Frame handle(const Protocol::Frame& request);
+};
+
+#endif // CONNECTION_H
@@ -0,0 +1,79 @@
+#include "GameServer.h"
+#include "Connection.h"
+
+#include <QDebug>
+
+Shard::Shard(QObject *parent)
+        : QObject(parent),
+          m_moves(0),
+          m_connections(0) {
+}
+
+Shard::~Shard() {
+}
+
+void Shard::accept(quintptr descriptor) {
+    Connection* connection = new Connection(descriptor, &m_moves, this);
+    if (!connection->isValid()) {
+        qWarning() << "gameserver: cannot adopt socket" << descriptor;
+        delete connection;
+        return;
+    }
+
+    QObject::connect(connection, SIGNAL(closed(Connection*)), this, SLOT(remove(Connection*)));
+    m_open.insert(connection);
+    m_connections.fetch_add(1, std::memory_order_relaxed);
+}
+
+void Shard::remove(Connection* connection) {
+    if (m_open.remove(connection)) {
+        m_connections.fetch_sub(1, std::memory_order_relaxed);
+        connection->deleteLater();
+    }
+}
+
+GameServer::GameServer(int threadCount, QObject *parent)
+        : QLocalServer(parent),
+          m_next(0) {
+    qRegisterMetaType<quintptr>("quintptr");
+
+    for (int i = 0; i < qMax(1, threadCount); ++i) {
+        QThread* thread = new QThread(this);
+        Shard* shard = new Shard;
+        shard->moveToThread(thread);
+        QObject::connect(thread, SIGNAL(finished()), shard, SLOT(deleteLater()));
+        thread->start();
+
+        m_threads.append(thread);
+        m_shards.append(shard);
+    }
+}
+
+GameServer::~GameServer() {
+    this->close();
+    for (QThread* thread : m_threads) {
+        thread->quit();
+        thread->wait();
+    }
+}
+
+quint64 GameServer::moves() const {
+    quint64 total = 0;
+    for (const Shard* shard : m_shards)
+        total += shard->moves();
+    return total;
+}
+
+int GameServer::connections() const {
+    int total = 0;
+    for (const Shard* shard : m_shards)
+        total += shard->connections();
+    return total;
+}
+
+void GameServer::incomingConnection(quintptr descriptor) {
+    Shard* shard = m_shards[m_next];
+    m_next = (m_next + 1) % m_shards.size();
+
+    QMetaObject::invokeMethod(shard, "accept", Qt::QueuedConnection, Q_ARG(quintptr, descriptor));
+}
@@ -0,0 +1,58 @@
+#ifndef GAMESERVER_H
+#define GAMESERVER_H
+
+#include <QLocalServer>
+#include <QList>
+#include <QSet>
+#include <QThread>
+
+#include <atomic>
+
+class Connection;
+
+// Um laco de eventos com as conexoes que recebeu; cada conexao carrega
+// quantas sessoes o cliente abrir.
+class Shard : public QObject {
+    Q_OBJECT
+
+public:
+    explicit Shard(QObject *parent = nullptr);
+    virtual ~Shard();
+
+    quint64 moves() const { return m_moves.load(std::memory_order_relaxed); }
+    int connections() const { return m_connections.load(std::memory_order_relaxed); }
+
+public slots:
+    void accept(quintptr descriptor);
+
+private slots:
+    void remove(Connection* connection);
+
+private:
+    QSet<Connection*> m_open;
+    std::atomic<quint64> m_moves;
+    std::atomic<int> m_connections;
+};
+
+// Aceita conexoes na thread principal e as distribui em rodizio entre
+// as threads dos Shards.
+class GameServer : public QLocalServer {
+    Q_OBJECT
+
+public:
+    explicit GameServer(int threadCount, QObject *parent = nullptr);
+    virtual ~GameServer();
+
+    quint64 moves() const;
+    int connections() const;
+
+protected:
+    void incomingConnection(quintptr descriptor) override;
+
+private:
+    QList<QThread*> m_threads;
+    QList<Shard*> m_shards;
+    int m_next;
+};
+
+#endif // GAMESERVER_H
@@ -0,0 +1,69 @@
+#include "SessionTable.h"
+
+uint32_t SessionTable::pack(const Board& board, bool finished) {
+    return static_cast<uint32_t>(board.pieces(Board::RedPlayer)) |
+           static_cast<uint32_t>(board.pieces(Board::BluePlayer)) << 13 |
+           static_cast<uint32_t>(board.player()) << 26 |
+           static_cast<uint32_t>(board.mode()) << 27 |
+           (finished ? FinishedBit : 0) | UsedBit;
+}
+
+Board SessionTable::unpack(uint32_t state) {
+    Board board(static_cast<Board::Mode>((state >> 27) & 1));
+    board.setPosition(static_cast<Mask>(state & 0x1FFF), static_cast<Mask>((state >> 13) & 0x1FFF),
+                      static_cast<Board::Player>((state >> 26) & 1));
+    return board;
+}
+
+uint32_t SessionTable::create(Board::Mode mode) {
+    uint32_t session;
+    if (m_free != NoSession) {
+        session = m_free;
+        m_free = m_slots[session];
+    } else {
+        session = static_cast<uint32_t>(m_slots.size());
+        m_slots.push_back(0);
+    }
+
+    m_slots[session] = SessionTable::pack(Board(mode), false);
+    ++m_active;
+    return session;
+}
+
+Protocol::Status SessionTable::play(uint32_t session, Move move) {
+    if (!this->isUsed(session))
+        return Protocol::UnknownSession;
+
+    uint32_t& state = m_slots[session];
+    if (state & FinishedBit)
+        return Protocol::Finished;
+
+    Board board = SessionTable::unpack(state);
+    if (!board.isLegal(move))
+        return Protocol::Illegal;
+
+    const Board::Player player = board.player();
+    board.play(move);
+
+    Protocol::Status status = Protocol::Accepted;
+    if (board.isWinningHole(player, move.to())) {
+        status = Protocol::Won;
+    } else {
+        Move moves[Board::MaxMoves];
+        if (board.generateMoves(moves) == 0)
+            status = Protocol::Blocked;
+    }
+
+    state = SessionTable::pack(board, status != Protocol::Accepted);
+    return status;
+}
+
+bool SessionTable::close(uint32_t session) {
+    if (!this->isUsed(session))
+        return false;
+
+    m_slots[session] = m_free;
+    m_free = session;
+    --m_active;
+    return true;
+}
@@ -0,0 +1,48 @@
+#ifndef SESSIONTABLE_H
+#define SESSIONTABLE_H
+
+#include "Board.h"
+#include "Protocol.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Sessoes de uma conexao, quatro bytes cada:
+//   bits  0..12  pecas vermelhas
+//   bits 13..25  pecas azuis
+//   bit  26      vez (Board::Player)
+//   bit  27      modo (Board::Mode)
+//   bit  28      partida encerrada
+//   bit  31      posicao ocupada
+// O numero de colocacoes e recuperado pela contagem de pecas. Posicoes
+// livres formam uma lista encadeada pelos proprios valores.
+class SessionTable {
+public:
+    SessionTable() : m_free(NoSession), m_active(0) {}
+
+    uint32_t create(Board::Mode mode);
+    Protocol::Status play(uint32_t session, Move move);
+    bool close(uint32_t session);
+
+    int active() const { return m_active; }
+    size_t capacity() const { return m_slots.size(); }
+
+private:
+    static const uint32_t NoSession = 0x7FFFFFFF;
+    static const uint32_t UsedBit = 1u << 31;
+    static const uint32_t FinishedBit = 1u << 28;
+
+    std::vector<uint32_t> m_slots;
+    uint32_t m_free;
+    int m_active;
+
+    bool isUsed(uint32_t session) const {
+        return session < m_slots.size() && (m_slots[session] & UsedBit);
+    }
+
+    static uint32_t pack(const Board& board, bool finished);
+    static Board unpack(uint32_t state);
+};
+
+#endif // SESSIONTABLE_H
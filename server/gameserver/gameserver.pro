@@ -0,0 +1,22 @@
+QT = core network
+
+TARGET = gameserver
+
+CONFIG += console c++11
+CONFIG -= app_bundle
+
+include(../../engine/engine.pri)
+
+INCLUDEPATH += ..
+
+SOURCES += \
+    Connection.cpp \
+    GameServer.cpp \
+    main.cpp \
+    SessionTable.cpp
+
+HEADERS += \
+    ../Protocol.h \
+    Connection.h \
+    GameServer.h \
+    SessionTable.h
@@ -0,0 +1,61 @@
+// Servidor de partidas sem interface: aceita clientes num QLocalServer e
+// hospeda quantas sessoes eles abrirem (ver server/Protocol.h).
+//
+// Uso: gameserver [--name picaria] [--threads N] [--stats segundos]
+
+#include "GameServer.h"
+#include "Protocol.h"
+
+#include <QCoreApplication>
+#include <QStringList>
+#include <QThread>
+#include <QTimer>
+
+#include <cstdio>
+
+int main(int argc, char *argv[]) {
+    QCoreApplication a(argc, argv);
+
+    QString name = Protocol::DefaultServerName;
+    int threads = QThread::idealThreadCount();
+    int stats = 0;
+
+    const QStringList args = a.arguments();
+    for (int i = 1; i < args.size(); ++i) {
+        if (args[i] == "--name" && i + 1 < args.size()) {
+            name = args[++i];
+        } else if (args[i] == "--threads" && i + 1 < args.size()) {
+            threads = args[++i].toInt();
+        } else if (args[i] == "--stats" && i + 1 < args.size()) {
+            stats = args[++i].toInt();
+        } else {
+            std::fprintf(stderr, "usage: gameserver [--name NAME] [--threads N] [--stats SECONDS]\n");
+            return 2;
+        }
+    }
+
+    GameServer server(threads);
+    QLocalServer::removeServer(name);
+    if (!server.listen(name)) {
+        std::fprintf(stderr, "gameserver: cannot listen on %s: %s\n",
+                     qPrintable(name), qPrintable(server.errorString()));
+        return 1;
+    }
+    std::printf("gameserver: listening on %s with %d threads\n", qPrintable(server.fullServerName()), qMax(1, threads));
+    std::fflush(stdout);
+
+    QTimer timer;
+    quint64 lastMoves = 0;
+    if (stats > 0) {
+        QObject::connect(&timer, &QTimer::timeout, [&]() {
+            const quint64 moves = server.moves();
+            std::printf("%d connections, %.0f moves/s\n", server.connections(),
+                        double(moves - lastMoves) / stats);
+            std::fflush(stdout);
+            lastMoves = moves;
+        });
+        timer.start(stats * 1000);
+    }
+
+    return a.exec();
+}
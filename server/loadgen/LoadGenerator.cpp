@@ -0,0 +1,209 @@
+#include "LoadGenerator.h"
+
+#include <QLocalSocket>
+#include <QTimer>
+
+#include <algorithm>
+#include <cstdio>
+
+LoadGenerator::LoadGenerator(const Options& options, QObject *parent)
+        : QObject(parent),
+          m_options(options),
+          m_random(options.seed ? options.seed : 1),
+          m_running(false),
+          m_sessions(0),
+          m_moves(0),
+          m_games(0),
+          m_errors(0) {
+}
+
+LoadGenerator::~LoadGenerator() {
+    qDeleteAll(m_clients);
+}
+
+void LoadGenerator::start() {
+    const int connections = qMax(1, m_options.connections);
+    m_sessions = 0;
+    for (int i = 0; i < connections; ++i) {
+        Client* client = new Client;
+        client->socket = new QLocalSocket(this);
+
+        // A etiqueta de 16 bits identifica a sessao dentro da conexao.
+        const int count = m_options.sessions / connections + (i < m_options.sessions % connections ? 1 : 0);
+        client->sessions.resize(qMin(count, 0x10000));
+        m_sessions += int(client->sessions.size());
+        for (Session& session : client->sessions)
+            session.board.reset(m_options.mode);
+
+        QObject::connect(client->socket, SIGNAL(connected()), this, SLOT(connected()));
+        QObject::connect(client->socket, SIGNAL(readyRead()), this, SLOT(process()));
+#if QT_VERSION >= QT_VERSION_CHECK(5, 15, 0)
+        QObject::connect(client->socket, &QLocalSocket::errorOccurred, this, &LoadGenerator::failed);
+#else
+        QObject::connect(client->socket, SIGNAL(error(QLocalSocket::LocalSocketError)), this, SLOT(failed()));
+#endif
+        m_clients.append(client);
+    }
+
+    m_running = true;
+    m_latencies.reserve(1 << 20);
+    if (m_sessions < m_options.sessions)
+        std::fprintf(stderr, "loadgen: at most %d sessions per connection, using %d\n", 0x10000, m_sessions);
+
+    m_clock.start();
+    for (Client* client : m_clients)
+        client->socket->connectToServer(m_options.serverName);
+
+    QTimer::singleShot(m_options.seconds * 1000, this, SLOT(stop()));
+}
+
+LoadGenerator::Client* LoadGenerator::clientFor(QObject* socket) const {
+    for (Client* client : m_clients) {
+        if (client->socket == socket)
+            return client;
+    }
+    return nullptr;
+}
+
+void LoadGenerator::connected() {
+    Client* client = this->clientFor(this->sender());
+    for (int tag = 0; tag < client->sessions.size(); ++tag)
+        this->send(client, tag, Protocol::NewGame, m_options.mode);
+
+    client->socket->write(client->output);
+    client->output.resize(0);
+}
+
+void LoadGenerator::send(Client* client, int tag, Protocol::Operation operation, int argument) {
+    Session& session = client->sessions[tag];
+
+    Protocol::Frame frame;
+    frame.operation = static_cast<uint8_t>(operation);
+    frame.argument = static_cast<uint8_t>(argument);
+    frame.tag = static_cast<uint16_t>(tag);
+    frame.session = session.id;
+
+    const int offset = client->output.size();
+    client->output.resize(offset + Protocol::FrameSize);
+    Protocol::encode(frame, client->output.data() + offset);
+    session.sentAt = m_clock.nsecsElapsed();
+}
+
+// Jogada aleatoria, ja aplicada no tabuleiro local para conferir a resposta.
+void LoadGenerator::playRandom(Client* client, int tag) {
+    Board& board = client->sessions[tag].board;
+
+    Move moves[Board::MaxMoves];
+    const int count = board.generateMoves(moves);
+    m_random ^= m_random << 13;
+    m_random ^= m_random >> 17;
+    m_random ^= m_random << 5;
+    const Move move = moves[m_random % count];
+
+    board.play(move);
+    this->send(client, tag, Protocol::Play, move.bits());
+}
+
+void LoadGenerator::process() {
+    Client* client = this->clientFor(this->sender());
+    client->input.append(client->socket->readAll());
+
+    const int frames = client->input.size() / Protocol::FrameSize;
+    const char* in = client->input.constData();
+    for (int i = 0; i < frames; ++i, in += Protocol::FrameSize)
+        this->handle(client, Protocol::decode(in));
+    client->input.remove(0, frames * Protocol::FrameSize);
+
+    if (!client->output.isEmpty()) {
+        client->socket->write(client->output);
+        client->output.resize(0);
+    }
+}
+
+void LoadGenerator::handle(Client* client, const Protocol::Frame& reply) {
+    if (reply.tag >= client->sessions.size()) {
+        ++m_errors;
+        return;
+    }
+
+    const int tag = reply.tag;
+    Session& session = client->sessions[tag];
+    const qint64 latency = m_clock.nsecsElapsed() - session.sentAt;
+
+    switch (reply.operation & ~Protocol::Reply) {
+        case Protocol::NewGame:
+            session.id = reply.session;
+            session.board.reset(m_options.mode);
+            if (reply.argument != Protocol::Accepted)
+                ++m_errors;
+            else if (m_running)
+                this->playRandom(client, tag);
+            break;
+        case Protocol::Play: {
+            ++m_moves;
+            m_latencies.push_back(static_cast<quint32>(qMin<qint64>(latency, 0xFFFFFFFF)));
+
+            const Board& board = session.board;
+            Move moves[Board::MaxMoves];
+            const bool won = board.hasWon(Board::opponent(board.player()));
+            const bool blocked = !won && board.generateMoves(moves) == 0;
+            const int expected = won ? Protocol::Won : blocked ? Protocol::Blocked : Protocol::Accepted;
+            if (reply.argument != expected)
+                ++m_errors;
+
+            if (reply.argument != Protocol::Accepted) {
+                ++m_games;
+                this->send(client, tag, Protocol::Close, 0);
+            } else if (m_running) {
+                this->playRandom(client, tag);
+            }
+            break;
+        }
+        case Protocol::Close:
+            if (reply.argument != Protocol::Accepted)
+                ++m_errors;
+            if (m_running)
+                this->send(client, tag, Protocol::NewGame, m_options.mode);
+            break;
+        default:
+            ++m_errors;
+            break;
+    }
+}
+
+void LoadGenerator::failed() {
+    QLocalSocket* socket = qobject_cast<QLocalSocket*>(this->sender());
+    std::fprintf(stderr, "loadgen: %s\n", qPrintable(socket->errorString()));
+    m_running = false;
+    emit finished(1);
+}
+
+void LoadGenerator::stop() {
+    if (!m_running)
+        return;
+
+    m_running = false;
+    this->report();
+
+    // Nenhuma jogada completa tambem e falha: o servidor nao respondeu.
+    if (m_moves == 0)
+        std::fprintf(stderr, "loadgen: no moves completed\n");
+    emit finished(m_errors == 0 && m_moves > 0 ? 0 : 1);
+}
+
+void LoadGenerator::report() {
+    const double seconds = m_clock.nsecsElapsed() / 1e9;
+
+    std::sort(m_latencies.begin(), m_latencies.end());
+    const auto percentile = [this](int p) -> double {
+        return m_latencies.empty() ? 0.0 : m_latencies[(m_latencies.size() - 1) * p / 100] / 1e3;
+    };
+
+    std::printf("sessions:  %d over %d connections\n", m_sessions, int(m_clients.size()));
+    std::printf("moves:     %llu (%.0f moves/s)\n", static_cast<unsigned long long>(m_moves), m_moves / seconds);
+    std::printf("games:     %llu\n", static_cast<unsigned long long>(m_games));
+    std::printf("latency:   p50 %.1f us, p99 %.1f us, max %.1f us\n",
+                percentile(50), percentile(99), m_latencies.empty() ? 0.0 : m_latencies.back() / 1e3);
+    std::printf("errors:    %llu\n", static_cast<unsigned long long>(m_errors));
+    std::fflush(stdout);
+}
@@ -0,0 +1,81 @@
+#ifndef LOADGENERATOR_H
+#define LOADGENERATOR_H
+
+#include <QObject>
+#include <QByteArray>
+#include <QElapsedTimer>
+#include <QList>
+#include <QVector>
+
+#include <vector>
+
+#include "Board.h"
+#include "Protocol.h"
+
+class QLocalSocket;
+
+// Abre varias sessoes em poucas conexoes e joga partidas aleatorias em
+// todas ao mesmo tempo, uma jogada pendente por sessao.
+class LoadGenerator : public QObject {
+    Q_OBJECT
+
+public:
+    struct Options {
+        QString serverName;
+        int connections;
+        int sessions;
+        int seconds;
+        Board::Mode mode;
+        quint32 seed;
+    };
+
+    explicit LoadGenerator(const Options& options, QObject *parent = nullptr);
+    virtual ~LoadGenerator();
+
+    void start();
+
+signals:
+    void finished(int exitCode);
+
+private slots:
+    void connected();
+    void process();
+    void failed();
+    void stop();
+
+private:
+    struct Session {
+        Session() : id(0), sentAt(0) {}
+
+        Board board;
+        quint32 id;
+        qint64 sentAt;
+    };
+
+    struct Client {
+        QLocalSocket* socket;
+        QVector<Session> sessions;
+        QByteArray input;
+        QByteArray output;
+    };
+
+    Options m_options;
+    QList<Client*> m_clients;
+    QElapsedTimer m_clock;
+    quint32 m_random;
+    bool m_running;
+    int m_sessions;                     // abertas de fato, apos o limite por conexao
+
+    quint64 m_moves;
+    quint64 m_games;
+    quint64 m_errors;
+    std::vector<quint32> m_latencies;
+
+    Client* clientFor(QObject* socket) const;
+    void send(Client* client, int tag, Protocol::Operation operation, int argument);
+    void playRandom(Client* client, int tag);
+    void handle(Client* client, const Protocol::Frame& reply);
+    void report();
+};
+
+#endif // LOADGENERATOR_H
@@ -0,0 +1,18 @@
+QT = core network
+
+TARGET = loadgen
+
+CONFIG += console c++11
+CONFIG -= app_bundle
+
+include(../../engine/engine.pri)
+
+INCLUDEPATH += ..
+
+SOURCES += \
+    LoadGenerator.cpp \
+    main.cpp
+
+HEADERS += \
+    ../Protocol.h \
+    LoadGenerator.h
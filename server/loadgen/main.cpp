@@ -0,0 +1,53 @@
+// Gerador de carga para o gameserver: abre N sessoes simultaneas, joga
+// partidas aleatorias e mede jogadas por segundo e latencia (p50/p99).
+//
+// Uso: loadgen [--name picaria] [--sessions 1000] [--connections 4]
+//              [--seconds 10] [--mode 9|13] [--seed N]
+
+#include "LoadGenerator.h"
+
+#include <QCoreApplication>
+#include <QStringList>
+
+#include <cstdio>
+
+int main(int argc, char *argv[]) {
+    QCoreApplication a(argc, argv);
+
+    LoadGenerator::Options options;
+    options.serverName = Protocol::DefaultServerName;
+    options.connections = 4;
+    options.sessions = 1000;
+    options.seconds = 10;
+    options.mode = Board::NineHoles;
+    options.seed = 1;
+
+    const QStringList args = a.arguments();
+    for (int i = 1; i < args.size(); ++i) {
+        const bool hasValue = i + 1 < args.size();
+        if (args[i] == "--name" && hasValue) {
+            options.serverName = args[++i];
+        } else if (args[i] == "--sessions" && hasValue) {
+            options.sessions = args[++i].toInt();
+        } else if (args[i] == "--connections" && hasValue) {
+            options.connections = args[++i].toInt();
+        } else if (args[i] == "--seconds" && hasValue) {
+            options.seconds = args[++i].toInt();
+        } else if (args[i] == "--mode" && hasValue) {
+            options.mode = args[++i] == "13" ? Board::ThirteenHoles : Board::NineHoles;
+        } else if (args[i] == "--seed" && hasValue) {
+            options.seed = args[++i].toUInt();
+        } else {
+            std::fprintf(stderr, "usage: loadgen [--name NAME] [--sessions N] [--connections N] "
+                                 "[--seconds N] [--mode 9|13] [--seed N]\n");
+            return 2;
+        }
+    }
+
+    LoadGenerator generator(options);
+    QObject::connect(&generator, &LoadGenerator::finished, &a, [](int code) { QCoreApplication::exit(code); },
+                     Qt::QueuedConnection);
+    generator.start();
+
+    return a.exec();
+}
@@ -0,0 +1,152 @@
+// Confere os nucleos de BatchEval com o Board e mede posicoes por segundo
+// de cada um, contra o laco de uma posicao por vez.
+//
+// Uso: batcheval [--count N] [--rounds N] [--mode 9|13|both]
+// As posicoes sao todas as do PositionIndex que cabem no modo, repetidas
+// ate N. Sai com codigo 1 se algum nucleo divergir da referencia.
+
+#include "BatchEval.h"
+#include "Board.h"
+#include "Evaluation.h"
+#include "PositionIndex.h"
+#include "Search.h"
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+namespace {
+
+struct Positions {
+    std::vector<Mask> red;
+    std::vector<Mask> blue;
+    std::vector<uint8_t> players;
+};
+
+Positions collect(Board::Mode mode, size_t count) {
+    Positions all;
+    Board board(mode);
+    for (int index = 0; index < PositionIndex::Size; ++index) {
+        if (!PositionIndex::position(index, board))
+            continue;
+        all.red.push_back(board.pieces(Board::RedPlayer));
+        all.blue.push_back(board.pieces(Board::BluePlayer));
+        all.players.push_back(static_cast<uint8_t>(board.player()));
+    }
+
+    Positions positions;
+    for (size_t i = 0; i < count; ++i) {
+        positions.red.push_back(all.red[i % all.red.size()]);
+        positions.blue.push_back(all.blue[i % all.red.size()]);
+        positions.players.push_back(all.players[i % all.red.size()]);
+    }
+    return positions;
+}
+
+double elapsed(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+// Uma posicao por vez pelo Board, como o jogo faz.
+void reference(Board::Mode mode, const Positions& positions, size_t i, uint8_t* winner, uint8_t* moveCount,
+               int16_t* score) {
+    Board board(mode);
+    board.setPosition(positions.red[i], positions.blue[i], static_cast<Board::Player>(positions.players[i]));
+    Move moves[Board::MaxMoves];
+    *winner = static_cast<uint8_t>((board.hasWon(Board::RedPlayer) ? BatchEval::RedWon : 0) |
+                                   (board.hasWon(Board::BluePlayer) ? BatchEval::BlueWon : 0));
+    *moveCount = static_cast<uint8_t>(board.generateMoves(moves));
+
+    const bool redWon = (*winner & BatchEval::RedWon) != 0;
+    if (*winner)
+        *score = static_cast<int16_t>(redWon == (board.player() == Board::RedPlayer) ? Search::WinScore : -Search::WinScore);
+    else
+        *score = static_cast<int16_t>(Evaluation::evaluate(board));
+}
+
+bool run(Board::Mode mode, size_t count, int rounds) {
+    const Positions positions = collect(mode, count);
+    const char* name = mode == Board::NineHoles ? "9" : "13";
+    std::vector<uint8_t> expectedWinners(count), expectedCounts(count);
+    std::vector<int16_t> expectedScores(count);
+
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    for (int round = 0; round < rounds; ++round) {
+        for (size_t i = 0; i < count; ++i)
+            reference(mode, positions, i, &expectedWinners[i], &expectedCounts[i], &expectedScores[i]);
+    }
+    double seconds = elapsed(start);
+    std::printf("%s,board,%zu,%.3f,%.0f\n", name, count * rounds, seconds, count * rounds / seconds);
+
+    BatchEval eval(mode);
+
+    bool ok = true;
+    for (int kernel = BatchEval::ScalarKernel; kernel <= BatchEval::bestKernel(); ++kernel) {
+        eval.setKernel(static_cast<BatchEval::Kernel>(kernel));
+        std::vector<uint8_t> winners(count), counts(count);
+        std::vector<int16_t> scores(count);
+
+        start = std::chrono::steady_clock::now();
+        for (int round = 0; round < rounds; ++round) {
+            eval.run(positions.red.data(), positions.blue.data(), positions.players.data(), count,
+                     winners.data(), counts.data(), scores.data());
+        }
+        seconds = elapsed(start);
+        std::printf("%s,%s,%zu,%.3f,%.0f\n", name, BatchEval::kernelName(eval.kernel()), count * rounds,
+                    seconds, count * rounds / seconds);
+
+        for (size_t i = 0; i < count; ++i) {
+            if (winners[i] != expectedWinners[i] || counts[i] != expectedCounts[i] || scores[i] != expectedScores[i]) {
+                std::fprintf(stderr, "batcheval: %s holes, %s kernel differs at position %zu\n",
+                             name, BatchEval::kernelName(eval.kernel()), i);
+                ok = false;
+                break;
+            }
+        }
+    }
+
+    return ok;
+}
+
+}
+
+int main(int argc, char *argv[]) {
+    size_t count = 1000000;
+    int rounds = 5;
+    std::vector<Board::Mode> modes;
+
+    for (int i = 1; i + 1 < argc; i += 2) {
+        std::string arg = argv[i];
+        std::string value = argv[i + 1];
+        if (arg == "--count") {
+            count = static_cast<size_t>(std::atol(value.c_str()));
+        } else if (arg == "--rounds") {
+            rounds = std::atoi(value.c_str());
+        } else if (arg == "--mode") {
+            if (value == "9" || value == "both")
+                modes.push_back(Board::NineHoles);
+            if (value == "13" || value == "both")
+                modes.push_back(Board::ThirteenHoles);
+        } else {
+            std::fprintf(stderr, "batcheval: unknown option %s\n", arg.c_str());
+            return 2;
+        }
+    }
+    if (modes.empty()) {
+        modes.push_back(Board::NineHoles);
+        modes.push_back(Board::ThirteenHoles);
+    }
+    if (count == 0 || rounds < 1) {
+        std::fprintf(stderr, "batcheval: --count and --rounds must be positive\n");
+        return 2;
+    }
+
+    bool ok = true;
+    std::printf("mode,kernel,positions,seconds,positions_per_second\n");
+    for (Board::Mode mode : modes)
+        ok = run(mode, count, rounds) && ok;
+
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,215 @@
+// Ajusta os pesos de Evaluation pelo metodo de Texel: minimiza o erro
+// quadratico medio entre o resultado de cada posicao e sigmoid(avaliacao),
+// mudando um peso de cada vez enquanto o erro cair.
+//
+// Uso: evaltune arquivo [--mode 9|13|both] [--threads N] [--passes N]
+//
+// O arquivo vem de tools/trainingdata, de preferencia com --label result
+// (resultado das partidas) ou --label tablebase. Rotulos de vitoria e de
+// derrota valem 1 e 0; os demais valem 0.5, ou sigmoid(rotulo) quando sao
+// pontuacoes de busca. Posicoes ja decididas ficam de fora, porque a busca
+// nunca as avalia. Os pesos saem no formato de s_weights em
+// engine/Evaluation.cpp.
+
+#include "Evaluation.h"
+#include "Search.h"
+#include "TrainingData.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+struct Sample {
+    int8_t features[Evaluation::FeatureCount];
+    float target;
+};
+
+double sigmoid(double score) {
+    return 1.0 / (1.0 + std::pow(10.0, -score / 400.0));
+}
+
+bool load(const std::string& path, TrainingRecord::Header& header, std::vector<TrainingRecord>& records) {
+    FILE* file = std::fopen(path.c_str(), "rb");
+    if (file == nullptr)
+        return false;
+
+    bool ok = std::fread(&header, sizeof(header), 1, file) == 1 && std::memcmp(header.magic, "PCTD", 4) == 0 &&
+              header.version == TrainingRecord::Version && header.recordSize == sizeof(TrainingRecord);
+    if (ok) {
+        TrainingRecord buffer[4096];
+        size_t count;
+        while ((count = std::fread(buffer, sizeof(TrainingRecord), 4096, file)) > 0)
+            records.insert(records.end(), buffer, buffer + count);
+    }
+    std::fclose(file);
+    return ok;
+}
+
+std::vector<Sample> samples(const std::vector<TrainingRecord>& records, Board::Mode mode, uint8_t label) {
+    const Topology& topology = Board::topology(mode);
+    std::vector<Sample> samples;
+    for (const TrainingRecord& record : records) {
+        if (record.mode() != mode)
+            continue;
+
+        const Mask own = record.player() == Board::RedPlayer ? record.red : record.blue;
+        const Mask other = record.player() == Board::RedPlayer ? record.blue : record.red;
+        Board board(mode);
+        board.setPosition(record.red, record.blue, record.player());
+        if (board.hasWon(Board::RedPlayer) || board.hasWon(Board::BluePlayer))
+            continue;
+
+        Sample sample;
+        int values[Evaluation::FeatureCount];
+        Evaluation::features(topology, own, other, values);
+        for (int i = 0; i < Evaluation::FeatureCount; ++i)
+            sample.features[i] = static_cast<int8_t>(values[i]);
+
+        if (record.label >= Search::WinThreshold)
+            sample.target = 1.0f;
+        else if (record.label <= -Search::WinThreshold)
+            sample.target = 0.0f;
+        else if (label == TrainingRecord::SearchLabel)
+            sample.target = static_cast<float>(sigmoid(record.label));
+        else
+            sample.target = 0.5f;
+        samples.push_back(sample);
+    }
+    return samples;
+}
+
+// Erro medio, com as amostras divididas entre as threads.
+double error(const std::vector<Sample>& samples, const Evaluation::Weights& weights, int threadCount) {
+    std::vector<double> sums(threadCount, 0.0);
+    std::vector<std::thread> threads;
+    const size_t chunk = (samples.size() + threadCount - 1) / threadCount;
+    for (int t = 0; t < threadCount; ++t) {
+        threads.push_back(std::thread([&, t]() {
+            const size_t begin = std::min(samples.size(), t * chunk);
+            const size_t end = std::min(samples.size(), begin + chunk);
+            double sum = 0;
+            for (size_t i = begin; i < end; ++i) {
+                int score = 0;
+                for (int f = 0; f < Evaluation::FeatureCount; ++f)
+                    score += weights.values[f] * samples[i].features[f];
+                const double delta = samples[i].target - sigmoid(score);
+                sum += delta * delta;
+            }
+            sums[t] = sum;
+        }));
+    }
+    for (std::thread& thread : threads)
+        thread.join();
+
+    double sum = 0;
+    for (double partial : sums)
+        sum += partial;
+    return samples.empty() ? 0.0 : sum / samples.size();
+}
+
+Evaluation::Weights tune(const std::vector<Sample>& samples, Evaluation::Weights weights, int threads, int passes) {
+    double best = error(samples, weights, threads);
+    std::printf("  initial error %.6f\n", best);
+
+    for (int step = 16; step >= 1; step /= 2) {
+        bool improved = true;
+        for (int pass = 0; improved && pass < passes; ++pass) {
+            improved = false;
+            for (int f = 0; f < Evaluation::FeatureCount; ++f) {
+                for (int direction = 1; direction >= -1; direction -= 2) {
+                    Evaluation::Weights candidate = weights;
+                    candidate.values[f] += direction * step;
+                    const double value = error(samples, candidate, threads);
+                    if (value < best) {
+                        best = value;
+                        weights = candidate;
+                        improved = true;
+                        break;
+                    }
+                }
+            }
+        }
+        std::printf("  step %2d: error %.6f\n", step, best);
+    }
+
+    return weights;
+}
+
+}
+
+int main(int argc, char *argv[]) {
+    std::string path;
+    std::vector<Board::Mode> modes;
+    int threads = static_cast<int>(std::thread::hardware_concurrency());
+    int passes = 100;
+
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg.compare(0, 2, "--") != 0) {
+            path = arg;
+            continue;
+        }
+        if (i + 1 >= argc) {
+            std::fprintf(stderr, "evaltune: missing value for %s\n", arg.c_str());
+            return 2;
+        }
+
+        std::string value = argv[++i];
+        if (arg == "--threads") {
+            threads = std::atoi(value.c_str());
+        } else if (arg == "--passes") {
+            passes = std::atoi(value.c_str());
+        } else if (arg == "--mode") {
+            if (value == "9" || value == "both")
+                modes.push_back(Board::NineHoles);
+            if (value == "13" || value == "both")
+                modes.push_back(Board::ThirteenHoles);
+        } else {
+            std::fprintf(stderr, "evaltune: unknown option %s\n", arg.c_str());
+            return 2;
+        }
+    }
+    if (path.empty()) {
+        std::fprintf(stderr, "usage: evaltune file [--mode 9|13|both] [--threads N] [--passes N]\n");
+        return 2;
+    }
+    if (modes.empty()) {
+        modes.push_back(Board::NineHoles);
+        modes.push_back(Board::ThirteenHoles);
+    }
+    threads = std::max(1, threads);
+
+    TrainingRecord::Header header;
+    std::vector<TrainingRecord> records;
+    if (!load(path, header, records)) {
+        std::fprintf(stderr, "evaltune: cannot read %s\n", path.c_str());
+        return 1;
+    }
+
+    for (Board::Mode mode : modes) {
+        std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+        const std::vector<Sample> data = samples(records, mode, header.label);
+        std::printf("%s holes: %zu positions\n", mode == Board::NineHoles ? "9" : "13", data.size());
+        if (data.empty())
+            continue;
+
+        const Evaluation::Weights weights = tune(data, Evaluation::weights(mode), threads, passes);
+        std::printf("  %.1f s\n    // %s\n    { {", std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count(),
+                    mode == Board::NineHoles ? "NineHoles" : "ThirteenHoles");
+        for (int f = 0; f < Evaluation::FeatureCount; ++f)
+            std::printf("%s %d", f ? "," : "", weights.values[f]);
+        std::printf(" } }\n");
+        for (int f = 0; f < Evaluation::FeatureCount; ++f)
+            std::printf("    %-12s %d\n", Evaluation::featureName(static_cast<Evaluation::Feature>(f)), weights.values[f]);
+    }
+
+    return 0;
+}
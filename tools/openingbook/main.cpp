@@ -0,0 +1,154 @@
+// Gera o livro de aberturas da fase de colocar para os dois modos.
+//
+// Uso: openingbook [diretorio] [--depth N]
+//
+// Se as tabelas de finais (tools/tablebase) estiverem no diretorio, as
+// jogadas do livro sao as perfeitas; senao cada posicao e analisada pela
+// busca alfa-beta ate a profundidade N (12 por padrao).
+
+#include "Board.h"
+#include "OpeningBook.h"
+#include "Search.h"
+#include "Symmetry.h"
+#include "Tablebase.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <unordered_set>
+#include <vector>
+
+namespace {
+
+// Posicoes canonicas da fase de colocar alcancaveis a partir do inicio,
+// sem as que ja terminaram.
+std::vector<Board> collectPositions(Board::Mode mode) {
+    std::vector<Board> positions;
+    std::unordered_set<uint32_t> seen;
+
+    std::vector<Board> frontier(1, Board(mode));
+    seen.insert(Symmetry::canonicalKey(frontier.back()));
+
+    while (!frontier.empty()) {
+        Board board = frontier.back();
+        frontier.pop_back();
+
+        if (board.phase() != Board::DropPhase || board.hasWon(Board::opponent(board.player())))
+            continue;
+
+        Board canonical;
+        Symmetry::canonicalize(board, canonical);
+        positions.push_back(canonical);
+
+        Move moves[Board::MaxMoves];
+        int count = board.generateMoves(moves);
+        for (int i = 0; i < count; ++i) {
+            Board child(board);
+            child.play(moves[i]);
+            if (seen.insert(Symmetry::canonicalKey(child)).second)
+                frontier.push_back(child);
+        }
+    }
+
+    return positions;
+}
+
+bool loadTablebase(const std::string& path, Board::Mode mode, std::vector<char>& buffer, Tablebase& tablebase) {
+    FILE* file = std::fopen(path.c_str(), "rb");
+    if (file == nullptr)
+        return false;
+
+    buffer.resize(sizeof(Tablebase::Header) + PositionIndex::Size * sizeof(uint16_t) + 1);
+    size_t size = std::fread(buffer.data(), 1, buffer.size(), file);
+    std::fclose(file);
+
+    return tablebase.attach(buffer.data(), size, mode);
+}
+
+OpeningBook::Entry fromTablebase(const Tablebase& tablebase, const Board& board) {
+    OpeningBook::Entry entry;
+    entry.key = Symmetry::canonicalKey(board);
+    entry.move = tablebase.bestMove(board).bits();
+    entry.result = static_cast<uint8_t>(tablebase.result(board));
+    entry.distance = static_cast<uint16_t>(tablebase.distance(board));
+    return entry;
+}
+
+// Sem tabela o resultado so e conhecido quando a busca acha um mate.
+OpeningBook::Entry fromSearch(Search& search, const Board& board, int depth) {
+    Search::Limits limits;
+    limits.maxDepth = depth;
+
+    // Cada posicao do zero: o livro nao depende da ordem de geracao.
+    search.clear();
+    Search::Result result = search.run(board, limits);
+
+    OpeningBook::Entry entry;
+    entry.key = Symmetry::canonicalKey(board);
+    entry.move = result.move.bits();
+    entry.result = Tablebase::Unknown;
+    entry.distance = 0;
+    if (result.score >= Search::WinThreshold) {
+        entry.result = Tablebase::Win;
+        entry.distance = static_cast<uint16_t>(Search::WinScore - result.score);
+    } else if (result.score <= -Search::WinThreshold) {
+        entry.result = Tablebase::Loss;
+        entry.distance = static_cast<uint16_t>(Search::WinScore + result.score);
+    }
+    return entry;
+}
+
+bool write(const std::string& path, Board::Mode mode, const std::vector<OpeningBook::Entry>& entries) {
+    FILE* file = std::fopen(path.c_str(), "wb");
+    if (file == nullptr)
+        return false;
+
+    OpeningBook::Header header = OpeningBook::makeHeader(mode, static_cast<uint32_t>(entries.size()));
+    bool ok = std::fwrite(&header, sizeof(header), 1, file) == 1 &&
+              std::fwrite(entries.data(), sizeof(OpeningBook::Entry), entries.size(), file) == entries.size();
+
+    return std::fclose(file) == 0 && ok;
+}
+
+}
+
+int main(int argc, char *argv[]) {
+    std::string directory = ".";
+    int depth = 12;
+    for (int i = 1; i < argc; ++i) {
+        if (std::strcmp(argv[i], "--depth") == 0 && i + 1 < argc)
+            depth = std::atoi(argv[++i]);
+        else
+            directory = argv[i];
+    }
+
+    Search search;
+    const Board::Mode modes[] = { Board::NineHoles, Board::ThirteenHoles };
+    for (Board::Mode mode : modes) {
+        std::vector<char> buffer;
+        Tablebase tablebase;
+        bool exact = loadTablebase(directory + "/" + Tablebase::fileName(mode), mode, buffer, tablebase);
+
+        std::vector<Board> positions = collectPositions(mode);
+        std::vector<OpeningBook::Entry> entries;
+        entries.reserve(positions.size());
+        for (const Board& board : positions)
+            entries.push_back(exact ? fromTablebase(tablebase, board) : fromSearch(search, board, depth));
+
+        std::sort(entries.begin(), entries.end(),
+                  [](const OpeningBook::Entry& a, const OpeningBook::Entry& b) { return a.key < b.key; });
+
+        std::string path = directory + "/" + OpeningBook::fileName(mode);
+        std::printf("%s: %d positions from %s\n", OpeningBook::fileName(mode),
+                    static_cast<int>(entries.size()), exact ? "tablebase" : "search");
+
+        if (!write(path, mode, entries)) {
+            std::fprintf(stderr, "openingbook: cannot write %s\n", path.c_str());
+            return 1;
+        }
+    }
+
+    return 0;
+}
@@ -0,0 +1,191 @@
+// Conta as folhas da arvore de jogadas ate a profundidade N a partir da
+// posicao inicial de cada modo e confere com os valores de referencia.
+//
+// Uma jogada que fecha uma linha conta como folha se estiver exatamente
+// na profundidade N e encerra o ramo se estiver antes.
+//
+// Uso: perft [--depth N] [--mode 9|13|both] [--board arquivo.board] [--json arquivo]
+// Com --board (repetivel) conta tambem tabuleiros descritos em texto
+// (ver boards/), conferindo com as contagens 'perft' da descricao; se ela
+// declara 'mode', confere tambem que o tabuleiro e o do modo em Board.
+// Sai com codigo 1 se alguma contagem divergir da referencia.
+
+#include "Board.h"
+#include "BoardDescription.h"
+#include "Variant.h"
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace {
+
+const int MaxReferenceDepth = 11;
+
+// Contagens de referencia nas profundidades 1..MaxReferenceDepth, conferidas
+// com uma implementacao independente das listas de setNeighbor() e das
+// linhas de isGameOver() originais. Zero = sem referencia.
+const uint64_t s_reference[2][MaxReferenceDepth] = {
+    // NineHoles
+    {
+        9ull, 72ull, 504ull, 3024ull, 15120ull, 54720ull, 247680ull, 1104480ull,
+        5047776ull, 23181408ull, 106669728ull
+    },
+    // ThirteenHoles
+    {
+        13ull, 156ull, 1716ull, 17160ull, 154440ull, 1166400ull, 8334288ull, 58650048ull,
+        432526608ull, 3184972704ull, 0ull
+    }
+};
+
+uint64_t perft(const Board& board, int depth) {
+    Move moves[Board::MaxMoves];
+    int count = board.generateMoves(moves);
+    if (depth == 1)
+        return count;
+
+    uint64_t nodes = 0;
+    const Board::Player player = board.player();
+    for (int i = 0; i < count; ++i) {
+        Board child(board);
+        child.play(moves[i]);
+        if (!child.isWinningHole(player, moves[i].to()))
+            nodes += perft(child, depth - 1);
+    }
+
+    return nodes;
+}
+
+struct Row {
+    std::string label;
+    int depth;
+    uint64_t nodes;
+    double seconds;
+    bool checked;
+    bool ok;
+};
+
+}
+
+int main(int argc, char *argv[]) {
+    int maxDepth = 9;
+    std::vector<Board::Mode> modes;
+    std::vector<std::unique_ptr<Variant> > variants;
+    std::string jsonPath;
+
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (i + 1 >= argc) {
+            std::fprintf(stderr, "perft: missing value for %s\n", arg.c_str());
+            return 2;
+        }
+
+        std::string value = argv[++i];
+        if (arg == "--depth") {
+            maxDepth = std::atoi(value.c_str());
+        } else if (arg == "--json") {
+            jsonPath = value;
+        } else if (arg == "--board") {
+            BoardDescription description;
+            std::string error;
+            std::unique_ptr<Variant> variant;
+            if (BoardDescription::load(value, description, &error))
+                variant = Variant::compile(description, &error);
+            if (!variant) {
+                std::fprintf(stderr, "perft: %s\n", error.c_str());
+                return 2;
+            }
+            if (description.mode != 0 &&
+                    !Board::matches(description.mode == 9 ? Board::NineHoles : Board::ThirteenHoles, description, &error)) {
+                std::fprintf(stderr, "perft: %s: %s\n", value.c_str(), error.c_str());
+                return 1;
+            }
+            variants.push_back(std::move(variant));
+        } else if (arg == "--mode") {
+            if (value == "9" || value == "both")
+                modes.push_back(Board::NineHoles);
+            if (value == "13" || value == "both")
+                modes.push_back(Board::ThirteenHoles);
+        } else {
+            std::fprintf(stderr, "perft: unknown option %s\n", arg.c_str());
+            return 2;
+        }
+    }
+    if (modes.empty() && variants.empty()) {
+        modes.push_back(Board::NineHoles);
+        modes.push_back(Board::ThirteenHoles);
+    }
+
+    std::vector<Row> rows;
+    bool ok = true;
+    const auto report = [&](Row& row, uint64_t reference) {
+        row.checked = reference != 0;
+        row.ok = !row.checked || row.nodes == reference;
+        ok = ok && row.ok;
+        rows.push_back(row);
+
+        std::printf("%-12s  depth %2d  %14llu nodes  %8.3f s  %12.0f nodes/s  %s\n",
+                    row.label.c_str(), row.depth,
+                    static_cast<unsigned long long>(row.nodes), row.seconds,
+                    row.seconds > 0 ? row.nodes / row.seconds : 0.0,
+                    !row.checked ? "-" : row.ok ? "ok" : "MISMATCH");
+    };
+
+    for (Board::Mode mode : modes) {
+        for (int depth = 1; depth <= maxDepth; ++depth) {
+            Board board(mode);
+
+            std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+            Row row;
+            row.label = mode == Board::NineHoles ? "9 holes" : "13 holes";
+            row.depth = depth;
+            row.nodes = perft(board, depth);
+            row.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+            report(row, depth <= MaxReferenceDepth ? s_reference[mode][depth - 1] : 0);
+        }
+    }
+
+    for (const std::unique_ptr<Variant>& variant : variants) {
+        const BoardDescription& description = variant->description();
+        std::printf("%s: %d holes, %d-bit masks%s\n", description.name.c_str(),
+                    description.holeCount, variant->maskBits(),
+                    description.mode == 9 ? ", same board as 9 holes" :
+                    description.mode == 13 ? ", same board as 13 holes" : "");
+
+        for (int depth = 1; depth <= maxDepth; ++depth) {
+            std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+            Row row;
+            row.label = description.name;
+            row.depth = depth;
+            row.nodes = variant->perft(depth);
+            row.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+            report(row, depth <= static_cast<int>(description.perft.size()) ? description.perft[depth - 1] : 0);
+        }
+    }
+
+    if (!jsonPath.empty()) {
+        FILE* file = std::fopen(jsonPath.c_str(), "w");
+        if (file == nullptr) {
+            std::fprintf(stderr, "perft: cannot write %s\n", jsonPath.c_str());
+            return 2;
+        }
+
+        std::fprintf(file, "[\n");
+        for (size_t i = 0; i < rows.size(); ++i) {
+            const Row& row = rows[i];
+            std::fprintf(file, "  {\"board\": \"%s\", \"depth\": %d, \"nodes\": %llu, \"seconds\": %.6f, "
+                               "\"nodesPerSecond\": %.0f, \"ok\": %s}%s\n",
+                         row.label.c_str(), row.depth,
+                         static_cast<unsigned long long>(row.nodes), row.seconds,
+                         row.seconds > 0 ? row.nodes / row.seconds : 0.0,
+                         row.ok ? "true" : "false", i + 1 < rows.size() ? "," : "");
+        }
+        std::fprintf(file, "]\n");
+        std::fclose(file);
+    }
+
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,10 @@
+TEMPLATE = app
+TARGET = perft
+
+CONFIG += console c++11
+CONFIG -= qt app_bundle
+
+include(../../engine/engine.pri)
+
+SOURCES += \
+    main.cpp
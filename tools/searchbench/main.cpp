@@ -0,0 +1,76 @@
+// Mede nos por segundo da busca com 1..N threads.
+//
+// Cada busca tem um numero fixo de nos, e nao de milissegundos: com tempo
+// fixo as posicoes resolvidas cedo mediriam so a partida das threads. Pelo
+// mesmo motivo as amostras sao meios de partida do modo de treze casas, que
+// nao se resolvem dentro do orcamento; o modo de nove casas inteiro se
+// resolve em menos de 100 mil nos.
+//
+// Uso: searchbench [nos por busca] [threads maximas]
+
+#include "Board.h"
+#include "Search.h"
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <thread>
+
+namespace {
+
+// Posicoes de teste: fase de mover do modo de treze casas, equilibradas e
+// ainda abertas depois de 10 milhoes de nos.
+struct Sample {
+    Mask red;
+    Mask blue;
+    Board::Player player;
+};
+
+const Sample s_samples[] = {
+    { 0x0640, 0x0182, Board::BluePlayer },      // 6 9 10 x 1 7 8
+    { 0x1050, 0x00a2, Board::RedPlayer },       // 4 6 12 x 1 5 7
+    { 0x0490, 0x0205, Board::BluePlayer },      // 4 7 10 x 0 2 9
+    { 0x1104, 0x0203, Board::RedPlayer }        // 2 8 12 x 0 1 9
+};
+
+}
+
+int main(int argc, char *argv[]) {
+    long long maxNodes = argc > 1 ? std::atoll(argv[1]) : 4000000;
+    if (maxNodes < 1)
+        maxNodes = 1;
+    int maxThreads = argc > 2 ? std::atoi(argv[2]) : static_cast<int>(std::thread::hardware_concurrency());
+    if (maxThreads < 1)
+        maxThreads = 1;
+
+    std::printf("threads,nodes,seconds,nps\n");
+    for (int threads = 1; threads <= maxThreads; ++threads) {
+        Search search(64);
+        search.setThreadCount(threads);
+
+        Search::Limits limits;
+        limits.maxNodes = static_cast<uint64_t>(maxNodes);
+
+        uint64_t nodes = 0;
+        double seconds = 0;
+        for (const Sample& sample : s_samples) {
+            Board board(Board::ThirteenHoles);
+            board.setPosition(sample.red, sample.blue, sample.player);
+            search.clear();
+
+            std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+            Search::Result result = search.run(board, limits);
+            seconds += std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+            nodes += result.nodes;
+
+            if (result.nodes < limits.maxNodes)
+                std::fprintf(stderr, "searchbench: %d threads solved a sample in %llu nodes (depth %d)\n", threads,
+                             static_cast<unsigned long long>(result.nodes), result.depth);
+        }
+
+        std::printf("%d,%llu,%.3f,%.0f\n", threads, static_cast<unsigned long long>(nodes),
+                    seconds, seconds > 0 ? nodes / seconds : 0.0);
+    }
+
+    return 0;
+}
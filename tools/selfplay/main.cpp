@@ -0,0 +1,272 @@
+// Partidas automaticas entre motores, em paralelo em todos os nucleos.
+//
+// Uso: selfplay [opcoes]
+//   --games N          partidas por modo (padrao 100000)
+//   --mode 9|13|both   modos jogados (padrao both)
+//   --threads N        threads (padrao: todos os nucleos)
+//   --red P, --blue P  jogador de cada cor: random, alphabeta ou mcts (padrao random)
+//   --depth N          profundidade do alphabeta (padrao 4)
+//   --playouts N       partidas simuladas por lance do mcts (padrao 1000)
+//   --repetitions N    empate quando a mesma posicao aparece N vezes (padrao 3; 0 desliga)
+//   --move-limit N     empate depois de N lances na fase de mover (padrao 0, desligado)
+//   --max-plies N      lances ate declarar a partida sem fim (padrao 200)
+//   --seed N           semente dos jogadores aleatorios
+
+#include "Board.h"
+#include "DrawRules.h"
+#include "Mcts.h"
+#include "Search.h"
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+struct Options {
+    Options()
+        : games(100000), threads(std::thread::hardware_concurrency()), depth(4),
+          playouts(1000), repetitions(3), moveLimit(0), maxPlies(200), seed(1) {
+        modes.push_back(Board::NineHoles);
+        modes.push_back(Board::ThirteenHoles);
+        players[0] = "random";
+        players[1] = "random";
+    }
+
+    long games;
+    int threads;
+    int depth;
+    int playouts;
+    int repetitions;
+    int moveLimit;
+    int maxPlies;
+    uint64_t seed;
+    std::vector<Board::Mode> modes;
+    std::string players[2];
+};
+
+class Player {
+public:
+    virtual ~Player() {}
+    virtual Move choose(const Board& board) = 0;
+};
+
+class RandomPlayer : public Player {
+public:
+    explicit RandomPlayer(uint64_t seed) : m_state(seed ? seed : 1) {}
+
+    Move choose(const Board& board) {
+        Move moves[Board::MaxMoves];
+        int count = board.generateMoves(moves);
+        if (count == 0)
+            return Move();
+
+        m_state ^= m_state >> 12;
+        m_state ^= m_state << 25;
+        m_state ^= m_state >> 27;
+        return moves[((m_state * 0x2545F4914F6CDD1Dull) >> 32) * count >> 32];
+    }
+
+private:
+    uint64_t m_state;
+};
+
+class AlphaBetaPlayer : public Player {
+public:
+    explicit AlphaBetaPlayer(int depth) : m_search(1) { m_limits.maxDepth = depth; }
+
+    Move choose(const Board& board) { return m_search.run(board, m_limits).move; }
+
+private:
+    Search m_search;
+    Search::Limits m_limits;
+};
+
+class MctsPlayer : public Player {
+public:
+    explicit MctsPlayer(int playouts) : m_mcts(1 << 16) { m_limits.maxPlayouts = playouts; }
+
+    Move choose(const Board& board) { return m_mcts.run(board, m_limits).move; }
+
+private:
+    Mcts m_mcts;
+    Mcts::Limits m_limits;
+};
+
+Player* createPlayer(const std::string& name, const Options& options, uint64_t seed) {
+    if (name == "alphabeta")
+        return new AlphaBetaPlayer(options.depth);
+    if (name == "mcts")
+        return new MctsPlayer(options.playouts);
+    return new RandomPlayer(seed);
+}
+
+struct Stats {
+    Stats() : games(0), plies(0), unfinished(0) { wins[0] = wins[1] = 0; draws[0] = draws[1] = 0; }
+
+    long games;
+    long wins[2];
+    long draws[2];      // por repeticao e por limite de lances
+    long plies;
+    long unfinished;    // atingiu --max-plies
+
+    void add(const Stats& other) {
+        games += other.games;
+        wins[0] += other.wins[0];
+        wins[1] += other.wins[1];
+        draws[0] += other.draws[0];
+        draws[1] += other.draws[1];
+        plies += other.plies;
+        unfinished += other.unfinished;
+    }
+};
+
+void playGames(const Options& options, Board::Mode mode, std::atomic<long>& next,
+               Stats& stats, uint64_t seed) {
+    std::unique_ptr<Player> players[2] = {
+        std::unique_ptr<Player>(createPlayer(options.players[0], options, seed * 2 + 1)),
+        std::unique_ptr<Player>(createPlayer(options.players[1], options, seed * 2 + 2))
+    };
+    DrawRules rules(options.repetitions, options.moveLimit);
+
+    while (next.fetch_add(1, std::memory_order_relaxed) < options.games) {
+        Board board(mode);
+        rules.reset(board);
+        DrawRules::Verdict draw = DrawRules::NoDraw;
+        int ply = 0;
+        int winner = -1;
+
+        for (; ply < options.maxPlies; ++ply) {
+            Board::Player player = board.player();
+            Move move = players[player]->choose(board);
+            if (move.isNull()) {
+                winner = Board::opponent(player);
+                break;
+            }
+
+            board.play(move);
+            if (board.isWinningHole(player, move.to())) {
+                winner = player;
+                ++ply;
+                break;
+            }
+
+            draw = rules.push(board);
+            if (draw != DrawRules::NoDraw) {
+                ++ply;
+                break;
+            }
+        }
+
+        ++stats.games;
+        stats.plies += ply;
+        if (winner >= 0)
+            ++stats.wins[winner];
+        else if (draw == DrawRules::Repetition)
+            ++stats.draws[0];
+        else if (draw == DrawRules::MoveLimit)
+            ++stats.draws[1];
+        else
+            ++stats.unfinished;
+    }
+}
+
+bool parse(int argc, char *argv[], Options& options) {
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (i + 1 >= argc) {
+            std::fprintf(stderr, "selfplay: missing value for %s\n", arg.c_str());
+            return false;
+        }
+
+        std::string value = argv[++i];
+        if (arg == "--games") {
+            options.games = std::atol(value.c_str());
+        } else if (arg == "--threads") {
+            options.threads = std::atoi(value.c_str());
+        } else if (arg == "--depth") {
+            options.depth = std::atoi(value.c_str());
+        } else if (arg == "--playouts") {
+            options.playouts = std::atoi(value.c_str());
+        } else if (arg == "--repetitions") {
+            options.repetitions = std::atoi(value.c_str());
+        } else if (arg == "--move-limit") {
+            options.moveLimit = std::atoi(value.c_str());
+        } else if (arg == "--max-plies") {
+            options.maxPlies = std::atoi(value.c_str());
+        } else if (arg == "--seed") {
+            options.seed = std::strtoull(value.c_str(), nullptr, 10);
+        } else if (arg == "--red" || arg == "--blue") {
+            if (value != "random" && value != "alphabeta" && value != "mcts") {
+                std::fprintf(stderr, "selfplay: unknown player %s\n", value.c_str());
+                return false;
+            }
+            options.players[arg == "--red" ? 0 : 1] = value;
+        } else if (arg == "--mode") {
+            options.modes.clear();
+            if (value == "9" || value == "both")
+                options.modes.push_back(Board::NineHoles);
+            if (value == "13" || value == "both")
+                options.modes.push_back(Board::ThirteenHoles);
+            if (options.modes.empty()) {
+                std::fprintf(stderr, "selfplay: unknown mode %s\n", value.c_str());
+                return false;
+            }
+        } else {
+            std::fprintf(stderr, "selfplay: unknown option %s\n", arg.c_str());
+            return false;
+        }
+    }
+
+    if (options.threads < 1)
+        options.threads = 1;
+    return true;
+}
+
+}
+
+int main(int argc, char *argv[]) {
+    Options options;
+    if (!parse(argc, argv, options))
+        return 2;
+
+    std::printf("%s (red) vs %s (blue), %ld games per mode, %d threads\n",
+                options.players[0].c_str(), options.players[1].c_str(), options.games, options.threads);
+
+    for (Board::Mode mode : options.modes) {
+        std::atomic<long> next(0);
+        std::vector<Stats> stats(options.threads);
+        std::vector<std::thread> threads;
+
+        std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+        for (int i = 0; i < options.threads; ++i) {
+            threads.push_back(std::thread(playGames, std::cref(options), mode, std::ref(next),
+                                          std::ref(stats[i]), options.seed * 1000 + i));
+        }
+        for (size_t i = 0; i < threads.size(); ++i)
+            threads[i].join();
+        double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+        Stats total;
+        for (size_t i = 0; i < stats.size(); ++i)
+            total.add(stats[i]);
+
+        double games = total.games ? static_cast<double>(total.games) : 1.0;
+        std::printf("\n%s holes: %ld games in %.2f s (%.0f games/s)\n",
+                    mode == Board::NineHoles ? "9" : "13", total.games, seconds,
+                    seconds > 0 ? total.games / seconds : 0.0);
+        std::printf("  red wins   %6.2f%%\n", 100.0 * total.wins[0] / games);
+        std::printf("  blue wins  %6.2f%%\n", 100.0 * total.wins[1] / games);
+        std::printf("  repetition %6.2f%%\n", 100.0 * total.draws[0] / games);
+        std::printf("  move limit %6.2f%%\n", 100.0 * total.draws[1] / games);
+        std::printf("  unfinished %6.2f%%\n", 100.0 * total.unfinished / games);
+        std::printf("  avg plies  %6.2f\n", total.plies / games);
+    }
+
+    return 0;
+}
@@ -0,0 +1,317 @@
+// Enumera todas as posicoes alcancaveis de cada modo com uma busca em
+// largura paralela, nivel a nivel, e grava o grafo do jogo em CSR.
+//
+// Uso: statespace [--mode 9|13|both] [--threads N] [--output diretorio]
+//
+// Formato de picaria-9.graph / picaria-13.graph (little-endian, sem
+// preenchimento, pensado para ser mapeado em memoria):
+//
+//   GraphHeader
+//   uint32 levels[levelCount + 1]     nos do nivel d: [levels[d], levels[d + 1])
+//   uint32 positions[nodeCount]       PositionIndex de cada no
+//   uint32 offsets[nodeCount + 1]     sucessores do no i: [offsets[i], offsets[i + 1])
+//   uint32 targets[edgeCount]         no de destino de cada aresta
+//   uint8  moves[edgeCount]           Move::bits() da jogada de cada aresta
+//
+// Os nos seguem a ordem da busca (nivel, depois PositionIndex). Posicoes
+// em que o ultimo a jogar fechou uma linha nao tem sucessores.
+
+#include "Board.h"
+#include "PositionIndex.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+struct GraphHeader {
+    char magic[4];      // "PCSG"
+    uint8_t mode;
+    uint8_t version;
+    uint16_t levelCount;
+    uint32_t nodeCount;
+    uint32_t edgeCount;
+};
+
+const uint32_t NoNode = 0xFFFFFFFF;
+
+// Divide [0, count) em fatias continuas, uma por thread.
+template <typename Function>
+void parallelFor(size_t count, int threadCount, Function function) {
+    std::vector<std::thread> threads;
+    const size_t chunk = (count + threadCount - 1) / threadCount;
+    for (int t = 0; t < threadCount; ++t) {
+        const size_t begin = std::min(count, t * chunk);
+        const size_t end = std::min(count, begin + chunk);
+        threads.push_back(std::thread(function, begin, end, t));
+    }
+    for (std::thread& thread : threads)
+        thread.join();
+}
+
+bool isWon(const Board& board) {
+    return board.hasWon(Board::opponent(board.player()));
+}
+
+struct LevelStats {
+    LevelStats() : nodes(0), drop(0), move(0), won(0), blocked(0), edges(0) {}
+
+    uint64_t nodes;
+    uint64_t drop;
+    uint64_t move;
+    uint64_t won;       // o ultimo a jogar fechou uma linha
+    uint64_t blocked;   // quem joga nao tem jogadas
+    uint64_t edges;
+};
+
+struct Graph {
+    std::vector<uint32_t> levels;
+    std::vector<uint32_t> positions;
+    std::vector<uint32_t> offsets;
+    std::vector<uint32_t> targets;
+    std::vector<uint8_t> moves;
+    std::vector<LevelStats> stats;
+    uint64_t branching[Board::MaxMoves + 1];
+};
+
+Graph enumerate(Board::Mode mode, int threadCount) {
+    Graph graph;
+    std::fill(graph.branching, graph.branching + Board::MaxMoves + 1, 0);
+
+    std::vector<std::atomic<uint8_t> > visited(PositionIndex::Size);
+    for (std::atomic<uint8_t>& flag : visited)
+        flag.store(0, std::memory_order_relaxed);
+
+    Board start(mode);
+    std::vector<uint32_t> frontier(1, static_cast<uint32_t>(PositionIndex::index(start)));
+    visited[frontier[0]].store(1, std::memory_order_relaxed);
+
+    // Busca em largura: cada thread expande uma fatia do nivel e marca os
+    // filhos com exchange, de modo que cada posicao entra uma so vez.
+    while (!frontier.empty()) {
+        graph.levels.push_back(static_cast<uint32_t>(graph.positions.size()));
+        graph.positions.insert(graph.positions.end(), frontier.begin(), frontier.end());
+
+        std::vector<std::vector<uint32_t> > found(threadCount);
+        std::vector<LevelStats> stats(threadCount);
+        std::vector<std::vector<uint64_t> > branching(threadCount, std::vector<uint64_t>(Board::MaxMoves + 1, 0));
+
+        parallelFor(frontier.size(), threadCount, [&](size_t begin, size_t end, int t) {
+            for (size_t i = begin; i < end; ++i) {
+                Board board(mode);
+                PositionIndex::position(frontier[i], board);
+
+                LevelStats& level = stats[t];
+                ++level.nodes;
+                ++(board.phase() == Board::DropPhase ? level.drop : level.move);
+                if (isWon(board)) {
+                    ++level.won;
+                    continue;
+                }
+
+                Move moves[Board::MaxMoves];
+                const int count = board.generateMoves(moves);
+                ++branching[t][count];
+                level.edges += count;
+                if (count == 0)
+                    ++level.blocked;
+
+                for (int m = 0; m < count; ++m) {
+                    Board child(board);
+                    child.play(moves[m]);
+                    const uint32_t index = static_cast<uint32_t>(PositionIndex::index(child));
+                    if (visited[index].exchange(1, std::memory_order_relaxed) == 0)
+                        found[t].push_back(index);
+                }
+            }
+        });
+
+        LevelStats total;
+        std::vector<uint32_t> next;
+        for (int t = 0; t < threadCount; ++t) {
+            next.insert(next.end(), found[t].begin(), found[t].end());
+            total.nodes += stats[t].nodes;
+            total.drop += stats[t].drop;
+            total.move += stats[t].move;
+            total.won += stats[t].won;
+            total.blocked += stats[t].blocked;
+            total.edges += stats[t].edges;
+            for (int b = 0; b <= Board::MaxMoves; ++b)
+                graph.branching[b] += branching[t][b];
+        }
+        graph.stats.push_back(total);
+
+        // Ordem deterministica, independente do numero de threads.
+        std::sort(next.begin(), next.end());
+        frontier.swap(next);
+    }
+    graph.levels.push_back(static_cast<uint32_t>(graph.positions.size()));
+
+    // Com todos os nos numerados, monta o CSR em duas passadas paralelas:
+    // graus, soma de prefixos e preenchimento.
+    const size_t nodeCount = graph.positions.size();
+    std::vector<uint32_t> node(PositionIndex::Size, NoNode);
+    for (size_t i = 0; i < nodeCount; ++i)
+        node[graph.positions[i]] = static_cast<uint32_t>(i);
+
+    graph.offsets.assign(nodeCount + 1, 0);
+    parallelFor(nodeCount, threadCount, [&](size_t begin, size_t end, int) {
+        for (size_t i = begin; i < end; ++i) {
+            Board board(mode);
+            PositionIndex::position(graph.positions[i], board);
+            Move moves[Board::MaxMoves];
+            graph.offsets[i + 1] = isWon(board) ? 0 : board.generateMoves(moves);
+        }
+    });
+    for (size_t i = 0; i < nodeCount; ++i)
+        graph.offsets[i + 1] += graph.offsets[i];
+
+    graph.targets.resize(graph.offsets[nodeCount]);
+    graph.moves.resize(graph.offsets[nodeCount]);
+    parallelFor(nodeCount, threadCount, [&](size_t begin, size_t end, int) {
+        for (size_t i = begin; i < end; ++i) {
+            const uint32_t first = graph.offsets[i];
+            const uint32_t count = graph.offsets[i + 1] - first;
+            if (count == 0)
+                continue;
+
+            Board board(mode);
+            PositionIndex::position(graph.positions[i], board);
+            Move moves[Board::MaxMoves];
+            board.generateMoves(moves);
+            for (uint32_t m = 0; m < count; ++m) {
+                Board child(board);
+                child.play(moves[m]);
+                graph.targets[first + m] = node[PositionIndex::index(child)];
+                graph.moves[first + m] = moves[m].bits();
+            }
+        }
+    });
+
+    return graph;
+}
+
+template <typename T>
+bool writeArray(FILE* file, const std::vector<T>& values) {
+    return values.empty() || std::fwrite(values.data(), sizeof(T), values.size(), file) == values.size();
+}
+
+bool write(const std::string& path, Board::Mode mode, const Graph& graph) {
+    FILE* file = std::fopen(path.c_str(), "wb");
+    if (file == nullptr)
+        return false;
+
+    GraphHeader header;
+    header.magic[0] = 'P';
+    header.magic[1] = 'C';
+    header.magic[2] = 'S';
+    header.magic[3] = 'G';
+    header.mode = static_cast<uint8_t>(mode);
+    header.version = 1;
+    header.levelCount = static_cast<uint16_t>(graph.levels.size() - 1);
+    header.nodeCount = static_cast<uint32_t>(graph.positions.size());
+    header.edgeCount = static_cast<uint32_t>(graph.targets.size());
+
+    bool ok = std::fwrite(&header, sizeof(header), 1, file) == 1 &&
+              writeArray(file, graph.levels) && writeArray(file, graph.positions) &&
+              writeArray(file, graph.offsets) && writeArray(file, graph.targets) &&
+              writeArray(file, graph.moves);
+
+    return std::fclose(file) == 0 && ok;
+}
+
+void report(Board::Mode mode, const Graph& graph, double seconds) {
+    std::printf("\n%s holes: %zu positions, %zu edges, %zu levels in %.3f s\n",
+                mode == Board::NineHoles ? "9" : "13", graph.positions.size(), graph.targets.size(),
+                graph.stats.size(), seconds);
+    std::printf("%5s %10s %10s %10s %10s %10s %10s\n", "level", "nodes", "drop", "move", "won", "blocked", "branching");
+
+    LevelStats total;
+    for (size_t d = 0; d < graph.stats.size(); ++d) {
+        const LevelStats& level = graph.stats[d];
+        const uint64_t expanded = level.nodes - level.won;
+        std::printf("%5zu %10llu %10llu %10llu %10llu %10llu %10.2f\n", d,
+                    static_cast<unsigned long long>(level.nodes), static_cast<unsigned long long>(level.drop),
+                    static_cast<unsigned long long>(level.move), static_cast<unsigned long long>(level.won),
+                    static_cast<unsigned long long>(level.blocked),
+                    expanded ? double(level.edges) / expanded : 0.0);
+        total.nodes += level.nodes;
+        total.drop += level.drop;
+        total.move += level.move;
+        total.won += level.won;
+        total.blocked += level.blocked;
+        total.edges += level.edges;
+    }
+    std::printf("%5s %10llu %10llu %10llu %10llu %10llu %10.2f\n", "total",
+                static_cast<unsigned long long>(total.nodes), static_cast<unsigned long long>(total.drop),
+                static_cast<unsigned long long>(total.move), static_cast<unsigned long long>(total.won),
+                static_cast<unsigned long long>(total.blocked),
+                total.nodes > total.won ? double(total.edges) / (total.nodes - total.won) : 0.0);
+
+    int lowest = -1, highest = 0;
+    std::printf("branching factor histogram (non-terminal positions):\n");
+    for (int b = 0; b <= Board::MaxMoves; ++b) {
+        if (graph.branching[b] == 0)
+            continue;
+        if (lowest < 0)
+            lowest = b;
+        highest = b;
+        std::printf("  %2d moves: %llu\n", b, static_cast<unsigned long long>(graph.branching[b]));
+    }
+    std::printf("branching factor: min %d, max %d\n", lowest, highest);
+}
+
+}
+
+int main(int argc, char *argv[]) {
+    std::vector<Board::Mode> modes;
+    int threads = static_cast<int>(std::thread::hardware_concurrency());
+    std::string directory;
+
+    for (int i = 1; i + 1 < argc; i += 2) {
+        std::string arg = argv[i];
+        std::string value = argv[i + 1];
+        if (arg == "--threads") {
+            threads = std::atoi(value.c_str());
+        } else if (arg == "--output") {
+            directory = value;
+        } else if (arg == "--mode") {
+            if (value == "9" || value == "both")
+                modes.push_back(Board::NineHoles);
+            if (value == "13" || value == "both")
+                modes.push_back(Board::ThirteenHoles);
+        } else {
+            std::fprintf(stderr, "statespace: unknown option %s\n", arg.c_str());
+            return 2;
+        }
+    }
+    if (modes.empty()) {
+        modes.push_back(Board::NineHoles);
+        modes.push_back(Board::ThirteenHoles);
+    }
+    threads = std::max(1, threads);
+
+    for (Board::Mode mode : modes) {
+        std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+        Graph graph = enumerate(mode, threads);
+        double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        report(mode, graph, seconds);
+
+        if (!directory.empty()) {
+            std::string path = directory + "/" + (mode == Board::NineHoles ? "picaria-9.graph" : "picaria-13.graph");
+            if (!write(path, mode, graph)) {
+                std::fprintf(stderr, "statespace: cannot write %s\n", path.c_str());
+                return 1;
+            }
+            std::printf("wrote %s\n", path.c_str());
+        }
+    }
+
+    return 0;
+}
@@ -0,0 +1,186 @@
+// Resolve os dois modos por analise retrograda e grava uma tabela por modo.
+//
+// Uso: tablebase [diretorio de saida]
+
+#include "Board.h"
+#include "PositionIndex.h"
+#include "Tablebase.h"
+
+#include <cstdio>
+#include <string>
+#include <vector>
+
+namespace {
+
+struct Graph {
+    std::vector<bool> reachable;
+    std::vector<int> offsets;       // sucessores de i: targets[offsets[i] .. offsets[i + 1])
+    std::vector<int> targets;
+};
+
+bool isTerminal(const Board& board) {
+    return board.hasWon(Board::opponent(board.player()));
+}
+
+Graph buildGraph(Board::Mode mode) {
+    Graph graph;
+    graph.reachable.assign(PositionIndex::Size, false);
+
+    std::vector<int> frontier;
+    Board start(mode);
+    int root = PositionIndex::index(start);
+    graph.reachable[root] = true;
+    frontier.push_back(root);
+
+    while (!frontier.empty()) {
+        int index = frontier.back();
+        frontier.pop_back();
+
+        Board board(mode);
+        PositionIndex::position(index, board);
+        if (isTerminal(board))
+            continue;
+
+        Move moves[Board::MaxMoves];
+        int count = board.generateMoves(moves);
+        for (int i = 0; i < count; ++i) {
+            Board child(board);
+            child.play(moves[i]);
+            int target = PositionIndex::index(child);
+            if (!graph.reachable[target]) {
+                graph.reachable[target] = true;
+                frontier.push_back(target);
+            }
+        }
+    }
+
+    graph.offsets.assign(PositionIndex::Size + 1, 0);
+    for (int index = 0; index < PositionIndex::Size; ++index) {
+        graph.offsets[index + 1] = graph.offsets[index];
+        if (!graph.reachable[index])
+            continue;
+
+        Board board(mode);
+        PositionIndex::position(index, board);
+        if (isTerminal(board))
+            continue;
+
+        Move moves[Board::MaxMoves];
+        int count = board.generateMoves(moves);
+        for (int i = 0; i < count; ++i) {
+            Board child(board);
+            child.play(moves[i]);
+            graph.targets.push_back(PositionIndex::index(child));
+        }
+        graph.offsets[index + 1] += count;
+    }
+
+    return graph;
+}
+
+std::vector<uint16_t> solve(const Graph& graph) {
+    const int size = PositionIndex::Size;
+
+    std::vector<int> predecessorOffsets(size + 1, 0);
+    for (size_t edge = 0; edge < graph.targets.size(); ++edge)
+        ++predecessorOffsets[graph.targets[edge] + 1];
+    for (int index = 0; index < size; ++index)
+        predecessorOffsets[index + 1] += predecessorOffsets[index];
+
+    std::vector<int> predecessors(graph.targets.size());
+    std::vector<int> fill(predecessorOffsets.begin(), predecessorOffsets.end() - 1);
+    for (int index = 0; index < size; ++index) {
+        for (int edge = graph.offsets[index]; edge < graph.offsets[index + 1]; ++edge)
+            predecessors[fill[graph.targets[edge]]++] = index;
+    }
+
+    std::vector<uint16_t> table(size, Tablebase::makeEntry(Tablebase::Unknown, 0));
+    std::vector<int> pending(size, 0);
+    std::vector<int> queue;
+    queue.reserve(size);
+
+    // Sem sucessores: ou o adversario acabou de fechar uma linha ou quem
+    // joga esta bloqueado. Nos dois casos e derrota imediata.
+    for (int index = 0; index < size; ++index) {
+        if (!graph.reachable[index])
+            continue;
+
+        pending[index] = graph.offsets[index + 1] - graph.offsets[index];
+        if (pending[index] == 0) {
+            table[index] = Tablebase::makeEntry(Tablebase::Loss, 0);
+            queue.push_back(index);
+        }
+    }
+
+    for (size_t head = 0; head < queue.size(); ++head) {
+        int index = queue[head];
+        Tablebase::Result result = Tablebase::result(table[index]);
+        int distance = Tablebase::distance(table[index]) + 1;
+
+        for (int edge = predecessorOffsets[index]; edge < predecessorOffsets[index + 1]; ++edge) {
+            int parent = predecessors[edge];
+            if (Tablebase::result(table[parent]) != Tablebase::Unknown)
+                continue;
+
+            if (result == Tablebase::Loss) {
+                table[parent] = Tablebase::makeEntry(Tablebase::Win, distance);
+                queue.push_back(parent);
+            } else if (--pending[parent] == 0) {
+                table[parent] = Tablebase::makeEntry(Tablebase::Loss, distance);
+                queue.push_back(parent);
+            }
+        }
+    }
+
+    for (int index = 0; index < size; ++index) {
+        if (graph.reachable[index] && Tablebase::result(table[index]) == Tablebase::Unknown)
+            table[index] = Tablebase::makeEntry(Tablebase::Draw, 0);
+    }
+
+    return table;
+}
+
+bool write(const std::string& path, Board::Mode mode, const std::vector<uint16_t>& table) {
+    FILE* file = std::fopen(path.c_str(), "wb");
+    if (file == nullptr)
+        return false;
+
+    Tablebase::Header header = Tablebase::makeHeader(mode);
+    bool ok = std::fwrite(&header, sizeof(header), 1, file) == 1 &&
+              std::fwrite(table.data(), sizeof(uint16_t), table.size(), file) == table.size();
+
+    return std::fclose(file) == 0 && ok;
+}
+
+}
+
+int main(int argc, char *argv[]) {
+    std::string directory = argc > 1 ? argv[1] : ".";
+
+    const Board::Mode modes[] = { Board::NineHoles, Board::ThirteenHoles };
+    for (Board::Mode mode : modes) {
+        Graph graph = buildGraph(mode);
+        std::vector<uint16_t> table = solve(graph);
+
+        int counts[4] = { 0, 0, 0, 0 };
+        for (uint16_t entry : table)
+            ++counts[Tablebase::result(entry)];
+
+        Board start(mode);
+        uint16_t root = table[PositionIndex::index(start)];
+        static const char* const names[] = { "unknown", "win", "loss", "draw" };
+
+        std::string path = directory + "/" + Tablebase::fileName(mode);
+        std::printf("%s: %d reachable, %d win, %d loss, %d draw; start is %s in %d\n",
+                    Tablebase::fileName(mode), PositionIndex::Size - counts[Tablebase::Unknown],
+                    counts[Tablebase::Win], counts[Tablebase::Loss], counts[Tablebase::Draw],
+                    names[Tablebase::result(root)], Tablebase::distance(root));
+
+        if (!write(path, mode, table)) {
+            std::fprintf(stderr, "tablebase: cannot write %s\n", path.c_str());
+            return 1;
+        }
+    }
+
+    return 0;
+}
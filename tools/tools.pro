@@ -0,0 +1,12 @@
+TEMPLATE = subdirs
+
+SUBDIRS += \
+    batcheval \
+    evaltune \
+    openingbook \
+    perft \
+    searchbench \
+    selfplay \
+    statespace \
+    tablebase \
+    trainingdata
@@ -0,0 +1,323 @@
+// Gera registros de treino (TrainingRecord) para ajustar a avaliacao.
+//
+// Uso: trainingdata [opcoes]
+//   --output arquivo       destino (padrao training.bin)
+//   --source S             statespace: todas as posicoes do PositionIndex
+//                          que cabem no modo; selfplay: posicoes de partidas
+//                          aleatorias (padrao selfplay)
+//   --label L              tablebase: valor exato (precisa das tabelas de
+//                          tools/tablebase); search: busca de profundidade
+//                          fixa; result: resultado da partida, so com
+//                          --source selfplay (padrao search)
+//   --tablebase diretorio  onde estao as tabelas (padrao .)
+//   --depth N              profundidade da busca (padrao 4)
+//   --games N              partidas por modo com --source selfplay (padrao 100000)
+//   --max-plies N          lances por partida (padrao 200)
+//   --mode 9|13|both       modos (padrao both)
+//   --threads N            threads (padrao: todos os nucleos)
+//   --buffer N             registros por buffer do gravador
+//   --seed N               semente das partidas aleatorias
+//
+// Cada thread rotula suas posicoes e entrega blocos ao TrainingWriter, que
+// grava em segundo plano.
+
+#include "Board.h"
+#include "PositionIndex.h"
+#include "Search.h"
+#include "Tablebase.h"
+#include "TrainingData.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+struct Options {
+    Options()
+        : output("training.bin"), source("selfplay"), label("search"), directory("."), depth(4),
+          games(100000), maxPlies(200), threads(std::thread::hardware_concurrency()),
+          bufferRecords(TrainingWriter::DefaultBufferRecords), seed(1) {
+    }
+
+    std::string output;
+    std::string source;
+    std::string label;
+    std::string directory;
+    int depth;
+    long games;
+    int maxPlies;
+    int threads;
+    size_t bufferRecords;
+    uint64_t seed;
+    std::vector<Board::Mode> modes;
+};
+
+// Registros acumulados por thread antes de cada TrainingWriter::append().
+const size_t BatchRecords = 4096;
+
+bool loadTablebase(const std::string& path, Board::Mode mode, std::vector<char>& buffer, Tablebase& tablebase) {
+    FILE* file = std::fopen(path.c_str(), "rb");
+    if (file == nullptr)
+        return false;
+
+    buffer.resize(sizeof(Tablebase::Header) + PositionIndex::Size * sizeof(uint16_t) + 1);
+    size_t size = std::fread(buffer.data(), 1, buffer.size(), file);
+    std::fclose(file);
+
+    return tablebase.attach(buffer.data(), size, mode);
+}
+
+// Rotula posicoes de um modo e entrega os registros em blocos.
+class Labeller {
+public:
+    Labeller(const Options& options, const Tablebase* tablebase, TrainingWriter& writer)
+        : m_tablebase(tablebase),
+          m_search(1),
+          m_writer(writer) {
+        m_limits.maxDepth = options.depth;
+        m_batch.reserve(BatchRecords);
+    }
+
+    ~Labeller() { this->flush(); }
+
+    // false se a posicao nao tem rotulo (inalcancavel segundo a tabela).
+    bool add(const Board& board) {
+        int label;
+        if (board.hasWon(Board::opponent(board.player()))) {
+            label = -Search::WinScore;
+        } else if (m_tablebase) {
+            const uint16_t entry = m_tablebase->entry(board);
+            const int distance = Tablebase::distance(entry);
+            switch (Tablebase::result(entry)) {
+            case Tablebase::Win:
+                label = Search::WinScore - distance;
+                break;
+            case Tablebase::Loss:
+                label = -(Search::WinScore - distance);
+                break;
+            case Tablebase::Draw:
+                label = 0;
+                break;
+            default:
+                return false;
+            }
+        } else {
+            label = m_search.run(board, m_limits).score;
+        }
+
+        this->add(board, label);
+        return true;
+    }
+
+    void add(const Board& board, int label) {
+        m_batch.push_back(TrainingRecord::make(board, label));
+        if (m_batch.size() == BatchRecords)
+            this->flush();
+    }
+
+    void flush() {
+        m_writer.append(m_batch.data(), m_batch.size());
+        m_batch.clear();
+    }
+
+private:
+    const Tablebase* m_tablebase;
+    Search m_search;
+    Search::Limits m_limits;
+    TrainingWriter& m_writer;
+    std::vector<TrainingRecord> m_batch;
+};
+
+void stateSpace(Board::Mode mode, std::atomic<int>& next, Labeller& labeller) {
+    const int Chunk = 256;
+    Board board(mode);
+    for (;;) {
+        const int first = next.fetch_add(Chunk, std::memory_order_relaxed);
+        if (first >= PositionIndex::Size)
+            break;
+
+        const int last = std::min(first + Chunk, PositionIndex::Size);
+        for (int index = first; index < last; ++index) {
+            // Quem joga nao pode ter uma linha: o lance anterior foi do outro.
+            if (PositionIndex::position(index, board) && !board.hasWon(board.player()))
+                labeller.add(board);
+        }
+    }
+}
+
+// Com --label result as posicoes de cada partida so sao rotuladas no fim,
+// pelo vencedor: +-(WinScore - lances ate o fim), ou 0 sem vencedor.
+void addResults(const std::vector<Board>& game, int winner, Labeller& labeller) {
+    const int last = static_cast<int>(game.size()) - 1;
+    for (int ply = 0; ply <= last; ++ply) {
+        const Board& board = game[ply];
+        const int score = Search::WinScore - (last - ply);
+        labeller.add(board, winner < 0 ? 0 : board.player() == winner ? score : -score);
+    }
+}
+
+void selfPlay(const Options& options, Board::Mode mode, std::atomic<long>& next, uint64_t seed, Labeller& labeller) {
+    const bool results = options.label == "result";
+    std::vector<Board> game;
+    uint64_t state = seed ? seed : 1;
+    while (next.fetch_add(1, std::memory_order_relaxed) < options.games) {
+        Board board(mode);
+        int winner = -1;
+        game.clear();
+        for (int ply = 0; ply < options.maxPlies; ++ply) {
+            if (results)
+                game.push_back(board);
+            else
+                labeller.add(board);
+
+            Move moves[Board::MaxMoves];
+            const int count = board.generateMoves(moves);
+            if (count == 0) {
+                winner = Board::opponent(board.player());
+                break;
+            }
+
+            state ^= state >> 12;
+            state ^= state << 25;
+            state ^= state >> 27;
+            const Move move = moves[((state * 0x2545F4914F6CDD1Dull) >> 32) * count >> 32];
+            const Board::Player player = board.player();
+            board.play(move);
+            if (board.isWinningHole(player, move.to())) {
+                winner = player;
+                if (results)
+                    game.push_back(board);
+                else
+                    labeller.add(board);
+                break;
+            }
+        }
+
+        if (results)
+            addResults(game, winner, labeller);
+    }
+}
+
+bool parse(int argc, char *argv[], Options& options) {
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (i + 1 >= argc) {
+            std::fprintf(stderr, "trainingdata: missing value for %s\n", arg.c_str());
+            return false;
+        }
+
+        std::string value = argv[++i];
+        if (arg == "--output") {
+            options.output = value;
+        } else if (arg == "--source" && (value == "statespace" || value == "selfplay")) {
+            options.source = value;
+        } else if (arg == "--label" && (value == "tablebase" || value == "search" || value == "result")) {
+            options.label = value;
+        } else if (arg == "--tablebase") {
+            options.directory = value;
+        } else if (arg == "--depth") {
+            options.depth = std::atoi(value.c_str());
+        } else if (arg == "--games") {
+            options.games = std::atol(value.c_str());
+        } else if (arg == "--max-plies") {
+            options.maxPlies = std::atoi(value.c_str());
+        } else if (arg == "--threads") {
+            options.threads = std::atoi(value.c_str());
+        } else if (arg == "--buffer") {
+            options.bufferRecords = static_cast<size_t>(std::atol(value.c_str()));
+        } else if (arg == "--seed") {
+            options.seed = std::strtoull(value.c_str(), nullptr, 10);
+        } else if (arg == "--mode") {
+            if (value == "9" || value == "both")
+                options.modes.push_back(Board::NineHoles);
+            if (value == "13" || value == "both")
+                options.modes.push_back(Board::ThirteenHoles);
+        } else {
+            std::fprintf(stderr, "trainingdata: bad option %s %s\n", arg.c_str(), value.c_str());
+            return false;
+        }
+    }
+
+    if (options.modes.empty()) {
+        options.modes.push_back(Board::NineHoles);
+        options.modes.push_back(Board::ThirteenHoles);
+    }
+    if (options.threads < 1)
+        options.threads = 1;
+    if (options.label == "result" && options.source != "selfplay") {
+        std::fprintf(stderr, "trainingdata: --label result needs --source selfplay\n");
+        return false;
+    }
+    return true;
+}
+
+}
+
+int main(int argc, char *argv[]) {
+    Options options;
+    if (!parse(argc, argv, options))
+        return 2;
+
+    const bool exact = options.label == "tablebase";
+    const TrainingRecord::Label label = exact ? TrainingRecord::TablebaseLabel
+                                      : options.label == "result" ? TrainingRecord::ResultLabel
+                                      : TrainingRecord::SearchLabel;
+
+    // As tabelas sao carregadas antes de abrir a saida: sem elas nao fica
+    // para tras um arquivo so com o cabecalho, que o evaltune leria como
+    // um conjunto vazio valido.
+    std::vector<char> buffers[2];
+    Tablebase tablebases[2];
+    for (Board::Mode mode : options.modes) {
+        if (exact && !loadTablebase(options.directory + "/" + Tablebase::fileName(mode), mode, buffers[mode],
+                                    tablebases[mode])) {
+            std::fprintf(stderr, "trainingdata: cannot load %s/%s\n", options.directory.c_str(), Tablebase::fileName(mode));
+            return 1;
+        }
+    }
+
+    TrainingWriter writer(options.bufferRecords);
+    if (!writer.open(options.output, label)) {
+        std::fprintf(stderr, "trainingdata: cannot write %s\n", options.output.c_str());
+        return 1;
+    }
+
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    for (Board::Mode mode : options.modes) {
+        const Tablebase& tablebase = tablebases[mode];
+        std::atomic<int> nextIndex(0);
+        std::atomic<long> nextGame(0);
+        std::vector<std::thread> threads;
+        for (int t = 0; t < options.threads; ++t) {
+            threads.push_back(std::thread([&, t]() {
+                Labeller labeller(options, exact ? &tablebase : nullptr, writer);
+                if (options.source == "statespace")
+                    stateSpace(mode, nextIndex, labeller);
+                else
+                    selfPlay(options, mode, nextGame, options.seed * 1000003 + t + 1, labeller);
+            }));
+        }
+        for (std::thread& thread : threads)
+            thread.join();
+    }
+
+    if (!writer.close()) {
+        std::fprintf(stderr, "trainingdata: error writing %s\n", options.output.c_str());
+        return 1;
+    }
+
+    const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    const uint64_t records = writer.written();
+    const uint64_t stalls = writer.stalls();
+    std::printf("%llu records in %.3f s (%.0f records/s), writer stalls: %llu\n",
+                static_cast<unsigned long long>(records), seconds, seconds > 0 ? records / seconds : 0.0,
+                static_cast<unsigned long long>(stalls));
+    return 0;
+}